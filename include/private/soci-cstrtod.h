@@ -10,15 +10,262 @@
 
 #include "soci/error.h"
 
+#include <float.h>
+#include <limits>
 #include <stdlib.h>
 #include <string.h>
 
+// FLT_EVAL_METHOD is only defined by float.h since C99 and C++11, but gcc
+// and clang predefine it in any case.
+#if defined(FLT_EVAL_METHOD)
+    #define SOCI_FLT_EVAL_METHOD FLT_EVAL_METHOD
+#elif defined(__FLT_EVAL_METHOD__)
+    #define SOCI_FLT_EVAL_METHOD __FLT_EVAL_METHOD__
+#endif
+
 namespace soci
 {
 
 namespace details
 {
 
+// Skip the leading white space in "C" locale, as strtod() and sscanf() do.
+inline
+char const* cstring_skip_space(char const* s)
+{
+    while (*s == ' ' || (*s >= '\t' && *s <= '\r'))
+    {
+        ++s;
+    }
+
+    return s;
+}
+
+// Locale-independent function for converting strings to integers of any,
+// signed or unsigned, type T without using sscanf() or strtoll().
+//
+// The string must contain an optionally signed decimal number, possibly
+// preceded by white space, and nothing else. If it does and the number is in
+// the range of T, it is stored in result and true is returned, otherwise
+// false is returned and result is not modified.
+template <typename T>
+bool cstring_to_integer(char const* s, T& result)
+{
+    s = cstring_skip_space(s);
+
+    bool negative = false;
+    if (*s == '-')
+    {
+        if (!std::numeric_limits<T>::is_signed)
+        {
+            return false;
+        }
+
+        negative = true;
+        ++s;
+    }
+    else if (*s == '+')
+    {
+        ++s;
+    }
+
+    if (*s < '0' || *s > '9')
+    {
+        return false;
+    }
+
+    // The absolute value of the minimal value of a signed type is one more
+    // than its maximal value, assuming two's complement representation.
+    unsigned long long const limit =
+        static_cast<unsigned long long>((std::numeric_limits<T>::max)())
+            + (negative ? 1 : 0);
+
+    unsigned long long value = 0;
+    for (; *s >= '0' && *s <= '9'; ++s)
+    {
+        unsigned const digit = static_cast<unsigned>(*s - '0');
+        if (value > (limit - digit) / 10)
+        {
+            return false;
+        }
+
+        value = value * 10 + digit;
+    }
+
+    if (*s != '\0')
+    {
+        return false;
+    }
+
+    if (negative)
+    {
+        result = value == limit
+            ? (std::numeric_limits<T>::min)()
+            : static_cast<T>(-static_cast<long long>(value));
+    }
+    else
+    {
+        result = static_cast<T>(value);
+    }
+
+    return true;
+}
+
+// Try to convert the string to double without using strtod() and without
+// any loss of precision.
+//
+// This only works for the strings of the form [+-]digits[.digits][e[+-]exp]
+// with at most 19 significant digits and only if both the mantissa and the
+// power of 10 are exactly representable as doubles, as the result of a single
+// floating point multiplication or division is then correctly rounded. This
+// covers the vast majority of the numbers found in practice, but if false is
+// returned, the caller must fall back to strtod().
+inline
+bool cstring_to_double_fast(char const* s, double& d)
+{
+    // The result is only correctly rounded if the operations are performed
+    // using double precision, e.g. not with x87 extended precision.
+#if defined(SOCI_FLT_EVAL_METHOD) && SOCI_FLT_EVAL_METHOD == 0
+    static double const powersOf10[] =
+    {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+        1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+        1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    int const maxExactPower = 22;
+
+    // Maximal integer such that all the smaller ones are exactly representable.
+    unsigned long long const maxExactMantissa = 1ULL << 53;
+
+    s = cstring_skip_space(s);
+
+    bool const negative = *s == '-';
+    if (*s == '-' || *s == '+')
+    {
+        ++s;
+    }
+
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+
+    for (; *s >= '0' && *s <= '9'; ++s)
+    {
+        hasDigits = true;
+        if (mantissa == 0 && *s == '0')
+        {
+            continue;
+        }
+
+        if (++digits > 19)
+        {
+            return false;
+        }
+
+        mantissa = mantissa * 10 + static_cast<unsigned>(*s - '0');
+    }
+
+    if (*s == '.')
+    {
+        for (++s; *s >= '0' && *s <= '9'; ++s)
+        {
+            hasDigits = true;
+            --exponent;
+            if (mantissa == 0 && *s == '0')
+            {
+                continue;
+            }
+
+            if (++digits > 19)
+            {
+                return false;
+            }
+
+            mantissa = mantissa * 10 + static_cast<unsigned>(*s - '0');
+        }
+    }
+
+    if (!hasDigits)
+    {
+        return false;
+    }
+
+    if (*s == 'e' || *s == 'E')
+    {
+        ++s;
+
+        bool const negativeExponent = *s == '-';
+        if (*s == '-' || *s == '+')
+        {
+            ++s;
+        }
+
+        if (*s < '0' || *s > '9')
+        {
+            return false;
+        }
+
+        int e = 0;
+        for (; *s >= '0' && *s <= '9'; ++s)
+        {
+            if (e > 1000)
+            {
+                return false;
+            }
+
+            e = e * 10 + (*s - '0');
+        }
+
+        exponent += negativeExponent ? -e : e;
+    }
+
+    if (*s != '\0')
+    {
+        return false;
+    }
+
+    if (mantissa == 0)
+    {
+        d = negative ? -0.0 : 0.0;
+        return true;
+    }
+
+    // Absorb the part of a too big exponent into the mantissa, if possible.
+    for (; exponent > maxExactPower; --exponent)
+    {
+        if (mantissa > maxExactMantissa / 10)
+        {
+            return false;
+        }
+
+        mantissa *= 10;
+    }
+
+    if (mantissa > maxExactMantissa || exponent < -maxExactPower)
+    {
+        return false;
+    }
+
+    double value = static_cast<double>(mantissa);
+    if (exponent < 0)
+    {
+        value /= powersOf10[-exponent];
+    }
+    else
+    {
+        value *= powersOf10[exponent];
+    }
+
+    d = negative ? -value : value;
+    return true;
+#else // SOCI_FLT_EVAL_METHOD != 0
+    (void)s;
+    (void)d;
+    return false;
+#endif // SOCI_FLT_EVAL_METHOD == 0
+}
+
 // Locale-independent, i.e. always using "C" locale, function for converting
 // strings to numbers.
 //
@@ -28,6 +275,12 @@ namespace details
 inline
 double cstring_to_double(char const* s)
 {
+    double d;
+    if (cstring_to_double_fast(s, d))
+    {
+        return d;
+    }
+
     // Unfortunately there is no clean way to parse a number in C locale
     // without this hack: normally, using std::istringstream with classic
     // locale should work, but some standard library implementations are buggy
@@ -39,7 +292,7 @@ double cstring_to_double(char const* s)
 
     // First try with the original input.
     char* end;
-    double d = strtod(s, &end);
+    d = strtod(s, &end);
 
     bool parsedOK;
     if (*end == '.')
@@ -49,13 +302,22 @@ double cstring_to_double(char const* s)
         //
         // In principle, values other than point or comma are possible but they
         // don't seem to be used in practice, so for now keep things simple.
+        //
+        // Avoid allocating memory for the copy of the string unless it is
+        // really long, which is very unlikely for a number.
+        char localBuf[128];
         size_t const bufSize = strlen(s) + 1;
-        char* const buf = new char[bufSize];
+        char* const buf = bufSize <= sizeof(localBuf)
+                            ? localBuf
+                            : new char[bufSize];
         strcpy(buf, s);
         buf[end - s] = ',';
         d = strtod(buf, &end);
         parsedOK = end != buf && *end == '\0';
-        delete [] buf;
+        if (buf != localBuf)
+        {
+            delete [] buf;
+        }
     }
     else
     {
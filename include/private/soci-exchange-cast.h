@@ -9,6 +9,7 @@
 #define SOCI_EXCHANGE_CAST_H_INCLUDED
 
 #include "soci/soci-backend.h"
+#include "soci/timestamp.h"
 #include "soci/type-wrappers.h"
 
 #include <ctime>
@@ -70,6 +71,12 @@ struct exchange_type_traits<x_stdtm>
   typedef std::tm value_type;
 };
 
+template <>
+struct exchange_type_traits<x_timestamp>
+{
+  typedef timestamp value_type;
+};
+
 template <>
 struct exchange_type_traits<x_longstring>
 {
@@ -82,6 +89,12 @@ struct exchange_type_traits<x_xmltype>
   typedef xml_type value_type;
 };
 
+template <>
+struct exchange_type_traits<x_stringref>
+{
+  typedef string_ref value_type;
+};
+
 // exchange_type_traits not defined for x_statement, x_rowid and x_blob here.
 
 template <exchange_type e>
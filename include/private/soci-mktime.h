@@ -10,6 +10,7 @@
 
 // Not <ctime> because we also want to get timegm() if available.
 #include <time.h>
+#include <cstddef>
 
 namespace soci
 {
@@ -39,11 +40,132 @@ mktime_from_ymdhms(tm& t,
     mktime(&t);
 }
 
+// Return the number of days since 1970-01-01 of the given date in the
+// proleptic Gregorian calendar. The day may be out of range for the given
+// month, but the month must be in 1..12 range.
+inline
+long days_from_civil(int year, int month, int day)
+{
+    // See http://howardhinnant.github.io/date_algorithms.html for the
+    // explanation of this algorithm.
+    if (month <= 2)
+    {
+        --year;
+    }
+
+    long const era = (year >= 0 ? year : year - 399) / 400;
+    long const yoe = year - era * 400;
+    long const doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5
+                        + day - 1;
+    long const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+}
+
+// Same as above, but the month may be out of range too.
+inline
+long days_from_ymd(int year, int month, int day)
+{
+    --month;
+    year += month >= 0 ? month / 12 : (month - 11) / 12;
+    month = (month % 12 + 12) % 12 + 1;
+
+    return days_from_civil(year, month, 1) + day - 1;
+}
+
+// Fill the provided struct tm with the values corresponding to the given
+// date, just as mktime_from_ymdhms() does, but without taking the local time
+// zone into account: this is much faster and doesn't modify the time of day
+// if it falls into a DST transition gap. The out of range values of all
+// fields are still normalized, and tm_isdst is set to -1 as the values don't
+// contain any information about DST.
+inline
+void
+tm_from_ymdhms(tm& t,
+               int year, int month, int day,
+               int hour, int minute, int second)
+{
+    long days = days_from_ymd(year, month, day);
+
+    long secs = hour * 3600L + minute * 60L + second;
+    long dayOffset = secs >= 0 ? secs / 86400 : (secs - 86399) / 86400;
+    days += dayOffset;
+    secs -= dayOffset * 86400;
+
+    // Convert the days back to the date, see days_from_civil().
+    long const z = days + 719468;
+    long const era = (z >= 0 ? z : z - 146096) / 146097;
+    long const doe = z - era * 146097;
+    long const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long const mp = (5 * doy + 2) / 153;
+
+    t.tm_mday = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    t.tm_mon  = static_cast<int>(mp < 10 ? mp + 2 : mp - 10);
+    t.tm_year = static_cast<int>(yoe + era * 400 + (t.tm_mon <= 1 ? 1 : 0))
+                    - 1900;
+
+    t.tm_hour = static_cast<int>(secs / 3600);
+    t.tm_min  = static_cast<int>(secs / 60 % 60);
+    t.tm_sec  = static_cast<int>(secs % 60);
+
+    // 1970-01-01 was a Thursday.
+    t.tm_wday = static_cast<int>(((days + 4) % 7 + 7) % 7);
+    t.tm_yday = static_cast<int>(
+        days - days_from_civil(t.tm_year + 1900, 1, 1));
+    t.tm_isdst = -1;
+}
+
 // Helper function for parsing datetime values.
 //
+// Dates and times in ISO 8601 format ("YYYY-MM-DD HH:MM:SS", with either a
+// space or "T" between the date and the time, or just the date or the time)
+// are parsed directly, other formats are still accepted, but handled more
+// slowly. Anything following the seconds and their fractional part, e.g. the
+// time zone offset, is ignored.
+//
 // Throws if the string in buf couldn't be parsed as a date or a time string.
 SOCI_DECL void parse_std_tm(char const *buf, std::tm &t);
 
+// Same as above, but also return the fractional part of the seconds, if any,
+// in microseconds.
+SOCI_DECL void parse_std_tm(char const *buf, std::tm &t, int &microseconds);
+
+// Parser for many datetime values, e.g. all values of a vector into element:
+// it's equivalent to calling parse_std_tm() for each of them, but the
+// calendar computations are done only once for consecutive values with the
+// same date.
+class SOCI_DECL std_tm_parser
+{
+public:
+    std_tm_parser() : hasLastDate_(false) {}
+
+    void parse(char const *buf, std::tm &t);
+    void parse(char const *buf, std::tm &t, int &microseconds);
+
+private:
+    bool hasLastDate_;
+    char lastDate_[10]; // "YYYY-MM-DD" part of the last parsed value
+    std::tm lastTm_;    // its value at midnight
+};
+
+// Parse the date and time, as parse_std_tm() does, into the number of
+// microseconds since 1970-01-01 00:00:00 used by soci::timestamp.
+SOCI_DECL long long parse_timestamp(char const *buf);
+
+// Format the value of soci::timestamp, as format_std_tm() does.
+SOCI_DECL int format_timestamp(char *buf, std::size_t bufSize,
+                               long long value);
+
+// Format the date and time in ISO 8601 format ("YYYY-MM-DD HH:MM:SS"),
+// followed by the fractional part of seconds if microseconds is not 0, into
+// the provided buffer.
+//
+// Just as snprintf(), returns the length of the full string, even if the
+// buffer was too small to store it and it had to be truncated.
+SOCI_DECL int format_std_tm(char *buf, std::size_t bufSize,
+                            std::tm const &t, int microseconds = 0);
+
 } // namespace details
 
 } // namespace soci
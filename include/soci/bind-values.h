@@ -12,6 +12,10 @@
 
 #ifdef SOCI_HAVE_BOOST
 #       include <boost/fusion/algorithm/iteration/for_each.hpp>
+#       include <boost/fusion/sequence/intrinsic/at_c.hpp>
+#       include <boost/fusion/sequence/intrinsic/size.hpp>
+#       include <boost/fusion/sequence/intrinsic/value_at.hpp>
+#       include <boost/fusion/support/is_sequence.hpp>
 #       include <boost/mpl/bool.hpp>
 #       include <boost/version.hpp>
 
@@ -28,6 +32,176 @@ namespace soci
 namespace details
 {
 
+#ifdef SOCI_HAVE_BOOST
+// Bulk exchange of std::vector<Seq>, where Seq is a fusion sequence (e.g. a
+// boost::tuple), is done column by column: each element position I of the
+// sequence gets its own std::vector holding the I-th field of every row,
+// bound with the usual vector into/use element. The columns are expanded at
+// compile time, so no dynamic values object is involved.
+
+template <typename Seq, int I>
+class vector_sequence_into_column : public into_type_base
+{
+public:
+    typedef typename boost::fusion::result_of::value_at_c<Seq, I>::type value_type;
+
+    vector_sequence_into_column(std::vector<Seq> & v, std::vector<indicator> * ind)
+        : v_(v), column_(v.size())
+    {
+        into_type_ptr p = ind != NULL
+            ? do_into(column_, *ind, 0, NULL,
+                typename exchange_traits<value_type>::type_family())
+            : do_into(column_, 0, NULL,
+                typename exchange_traits<value_type>::type_family());
+        inner_ = p.get();
+        p.release();
+    }
+
+    ~vector_sequence_into_column() { delete inner_; }
+
+    void define(statement_impl & st, int & position) SOCI_OVERRIDE
+    { inner_->define(st, position); }
+
+    void pre_exec(int num) SOCI_OVERRIDE { inner_->pre_exec(num); }
+
+    void pre_fetch() SOCI_OVERRIDE
+    {
+        column_.resize(v_.size());
+        inner_->pre_fetch();
+    }
+
+    void post_fetch(bool gotData, bool calledFromFetch) SOCI_OVERRIDE
+    {
+        inner_->post_fetch(gotData, calledFromFetch);
+
+        std::size_t const sz = column_.size() < v_.size()
+            ? column_.size() : v_.size();
+        for (std::size_t i = 0; i != sz; ++i)
+        {
+            boost::fusion::at_c<I>(v_[i]) = column_[i];
+        }
+    }
+
+    void clean_up() SOCI_OVERRIDE { inner_->clean_up(); }
+
+    std::size_t size() const SOCI_OVERRIDE
+    {
+        // the user vector may have been resized since the previous fetch
+        column_.resize(v_.size());
+        return inner_->size();
+    }
+
+    void resize(std::size_t sz) SOCI_OVERRIDE
+    {
+        inner_->resize(sz);
+        v_.resize(sz);
+    }
+
+private:
+    std::vector<Seq> & v_;
+    mutable std::vector<value_type> column_;
+    into_type_base * inner_;
+
+    SOCI_NOT_COPYABLE(vector_sequence_into_column)
+};
+
+template <typename Seq, int I>
+class vector_sequence_use_column : public use_type_base
+{
+public:
+    typedef typename boost::fusion::result_of::value_at_c<Seq, I>::type value_type;
+
+    vector_sequence_use_column(std::vector<Seq> const & v, std::vector<indicator> * ind)
+        : v_(v)
+    {
+        gather();
+
+        use_type_ptr p = ind != NULL
+            ? do_use(column_, *ind, 0, NULL, std::string(),
+                typename exchange_traits<value_type>::type_family())
+            : do_use(column_, 0, NULL, std::string(),
+                typename exchange_traits<value_type>::type_family());
+        inner_ = p.get();
+        p.release();
+    }
+
+    ~vector_sequence_use_column() { delete inner_; }
+
+    void bind(statement_impl & st, int & position) SOCI_OVERRIDE
+    { inner_->bind(st, position); }
+
+    std::string get_name() const SOCI_OVERRIDE { return inner_->get_name(); }
+
+    void dump_value(std::ostream & os) const SOCI_OVERRIDE
+    { inner_->dump_value(os); }
+
+    void pre_exec(int num) SOCI_OVERRIDE { inner_->pre_exec(num); }
+
+    void pre_use() SOCI_OVERRIDE
+    {
+        gather();
+        inner_->pre_use();
+    }
+
+    void post_use(bool gotData) SOCI_OVERRIDE { inner_->post_use(gotData); }
+
+    void clean_up() SOCI_OVERRIDE { inner_->clean_up(); }
+
+    std::size_t size() const SOCI_OVERRIDE { return inner_->size(); }
+
+private:
+    void gather()
+    {
+        std::size_t const sz = v_.size();
+        column_.resize(sz);
+        for (std::size_t i = 0; i != sz; ++i)
+        {
+            column_[i] = boost::fusion::at_c<I>(v_[i]);
+        }
+    }
+
+    std::vector<Seq> const & v_;
+    std::vector<value_type> column_;
+    use_type_base * inner_;
+
+    SOCI_NOT_COPYABLE(vector_sequence_use_column)
+};
+
+template <typename Seq, int I, int N>
+struct vector_sequence_columns
+{
+    template <typename Exchange>
+    static void into(Exchange & p, std::vector<Seq> & v, std::vector<indicator> * ind)
+    {
+        p.exchange(into_type_ptr(new vector_sequence_into_column<Seq, I>(v, ind)));
+        vector_sequence_columns<Seq, I + 1, N>::into(p, v, ind);
+    }
+
+    template <typename Exchange>
+    static void use(Exchange & p, std::vector<Seq> const & v, std::vector<indicator> * ind)
+    {
+        p.exchange(use_type_ptr(new vector_sequence_use_column<Seq, I>(v, ind)));
+        vector_sequence_columns<Seq, I + 1, N>::use(p, v, ind);
+    }
+};
+
+template <typename Seq, int N>
+struct vector_sequence_columns<Seq, N, N>
+{
+    template <typename Exchange>
+    static void into(Exchange &, std::vector<Seq> &, std::vector<indicator> *) {}
+
+    template <typename Exchange>
+    static void use(Exchange &, std::vector<Seq> const &, std::vector<indicator> *) {}
+};
+
+template <typename Seq>
+struct vector_sequence
+    : vector_sequence_columns<Seq, 0, boost::fusion::result_of::size<Seq>::type::value>
+{
+};
+#endif // SOCI_HAVE_BOOST
+
 class use_type_vector: public std::vector<use_type_base *>
 {
 public:
@@ -105,6 +279,25 @@ private:
                                     SOCI_BOOST_FUSION_FOREACH_REFERENCE>(uc.t, f);
     }
 
+    template <typename T, typename Indicator>
+    void exchange_(use_container<std::vector<T>, Indicator> const &uc, boost::mpl::false_ *)
+    { exchange_vector_(uc, (typename boost::fusion::traits::is_sequence<T>::type *)NULL); }
+
+    template <typename T, typename Indicator>
+    void exchange_(use_container<const std::vector<T>, Indicator> const &uc, boost::mpl::false_ *)
+    { exchange_vector_(uc, (typename boost::fusion::traits::is_sequence<T>::type *)NULL); }
+
+    template <typename V, typename Indicator>
+    void exchange_vector_(use_container<V, Indicator> const &uc, boost::mpl::true_ * /* vector of fusion sequences */)
+    { vector_sequence<typename V::value_type>::use(*this, uc.t, &uc.ind); }
+
+    template <typename V>
+    void exchange_vector_(use_container<V, details::no_indicator> const &uc, boost::mpl::true_ * /* vector of fusion sequences */)
+    { vector_sequence<typename V::value_type>::use(*this, uc.t, NULL); }
+
+    template <typename V, typename Indicator>
+    void exchange_vector_(use_container<V, Indicator> const &uc, ...)
+    { exchange_(uc, static_cast<void *>(NULL)); }
 #endif // SOCI_HAVE_BOOST
 
     template <typename T, typename Indicator>
@@ -200,6 +393,22 @@ private:
                                 into_sequence<T, details::no_indicator>
                                     SOCI_BOOST_FUSION_FOREACH_REFERENCE>(ic.t, f);
     }
+
+    template <typename T, typename Indicator>
+    void exchange_(into_container<std::vector<T>, Indicator> const &ic, boost::mpl::false_ *)
+    { exchange_vector_(ic, (typename boost::fusion::traits::is_sequence<T>::type *)NULL); }
+
+    template <typename T, typename Indicator>
+    void exchange_vector_(into_container<std::vector<T>, Indicator> const &ic, boost::mpl::true_ * /* vector of fusion sequences */)
+    { vector_sequence<T>::into(*this, ic.t, &ic.ind); }
+
+    template <typename T>
+    void exchange_vector_(into_container<std::vector<T>, details::no_indicator> const &ic, boost::mpl::true_ * /* vector of fusion sequences */)
+    { vector_sequence<T>::into(*this, ic.t, NULL); }
+
+    template <typename T, typename Indicator>
+    void exchange_vector_(into_container<std::vector<T>, Indicator> const &ic, ...)
+    { exchange_(ic, static_cast<void *>(NULL)); }
 #endif // SOCI_HAVE_BOOST
 
     template <typename T, typename Indicator>
@@ -10,6 +10,7 @@
 
 #include "soci/type-conversion-traits.h"
 #include "soci/soci-backend.h"
+#include "soci/timestamp.h"
 #include "soci/type-wrappers.h"
 // std
 #include <ctime>
@@ -125,6 +126,13 @@ struct exchange_traits<std::tm>
     enum { x_type = x_stdtm };
 };
 
+template <>
+struct exchange_traits<timestamp>
+{
+    typedef basic_type_tag type_family;
+    enum { x_type = x_timestamp };
+};
+
 template <typename T>
 struct exchange_traits<std::vector<T> >
 {
@@ -148,6 +156,13 @@ struct exchange_traits<long_string>
     enum { x_type = x_longstring };
 };
 
+template <>
+struct exchange_traits<string_ref>
+{
+    typedef basic_type_tag type_family;
+    enum { x_type = x_stringref };
+};
+
 } // namespace details
 
 } // namespace soci
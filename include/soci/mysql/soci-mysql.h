@@ -25,10 +25,21 @@
 #endif
 
 #include <soci/soci-backend.h>
+#include <soci/timestamp.h>
 #ifdef _WIN32
 #include <winsock.h> // SOCKET
 #endif // _WIN32
 #include <mysql.h> // MySQL Client
+
+// MariaDB Connector/C provides non-blocking versions of the API functions.
+#ifdef MYSQL_WAIT_READ
+#define SOCI_MYSQL_NONBLOCKING
+#endif
+#include <ctime>
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 
@@ -166,10 +177,68 @@ struct mysql_statement_backend : details::statement_backend
     mysql_vector_into_type_backend * make_vector_into_type_backend() SOCI_OVERRIDE;
     mysql_vector_use_type_backend * make_vector_use_type_backend() SOCI_OVERRIDE;
 
+    // Called by the use elements instead of formatting their values as text
+    // when the statement is executed as a server-side prepared statement.
+    void bind_prepared_param(int position, std::string const &name,
+        void *data, details::exchange_type type, indicator const *ind,
+        bool isVector);
+
+    // Return the given row of the current result and the lengths of its
+    // values, used by the into elements.
+    MYSQL_ROW get_row(int row, unsigned long *&lengths);
+
+    // Called by the into elements when the statement is executed as a
+    // server-side prepared statement: if the column was retrieved in its
+    // binary form, store the value from get_row() in the variable of the
+    // given type and return true, otherwise return false and let the caller
+    // convert the text value.
+    bool get_native_value(int pos, char const *buf,
+        details::exchange_type type, void *data);
+
     mysql_session_backend &session_;
 
     MYSQL_RES *result_;
 
+    // Server-side prepared statement, only used for the queries and the
+    // statements modifying the data if the statement cache is enabled in the
+    // session, otherwise the query is sent as text. For the queries, result_
+    // holds only the description of the columns.
+    MYSQL_STMT *stmt_;
+    std::string preparedQuery_; // the query with "?" placeholders
+
+    // Position of the row of values in a simple INSERT statement to which
+    // more rows can be appended in bulk mode, or npos.
+    std::string::size_type insertValuesPos_;
+
+    // The use elements bound to stmt_ and the buffers for their values.
+    struct prepared_param
+    {
+        void *data_;
+        details::exchange_type type_;
+        indicator const *ind_;
+        bool isVector_;
+    };
+    typedef std::map<int, prepared_param> PreparedParamsByPosMap;
+    PreparedParamsByPosMap preparedParamsByPos_;
+    typedef std::map<std::string, prepared_param> PreparedParamsByNameMap;
+    PreparedParamsByNameMap preparedParamsByName_;
+    std::vector<MYSQL_BIND> paramBinds_;
+    std::vector<unsigned long> paramLengths_;
+    std::vector<MYSQL_TIME> paramTimes_;
+
+    // The types of the into elements by position, recorded when they are
+    // defined, to retrieve the columns in the matching form.
+    typedef std::map<int, details::exchange_type> IntoTypesMap;
+    IntoTypesMap intoTypes_;
+
+    // The buffers to which the columns of stmt_ are bound: the numbers and
+    // the dates are retrieved in their binary form, all the other values and
+    // those fetched into strings are retrieved as text.
+    std::vector<MYSQL_BIND> resultBinds_;
+    std::vector<std::vector<char> > resultBuffers_;
+    std::vector<unsigned long> resultLengths_;
+    std::vector<char> resultNulls_; // storage for the is_null flags
+
     // The query is split into chunks, separated by the named parameters;
     // e.g. for "SELECT id FROM ttt WHERE name = :foo AND gender = :bar"
     // we will have query chunks "SELECT id FROM ttt WHERE name = ",
@@ -190,6 +259,14 @@ struct mysql_statement_backend : details::statement_backend
     // random access to rows, since mysql_data_seek() is expensive.
     std::vector<MYSQL_ROW_OFFSET> resultRowOffsets_;
 
+    // In the streaming mode, and for the prepared statements, the rows
+    // consumed by the current fetch are copied here, as mysql_fetch_row()
+    // and mysql_stmt_fetch() reuse the memory for each row.
+    std::vector<char> streamedData_;
+    std::vector<std::size_t> streamedOffsets_; // npos for NULL values
+    std::vector<char *> streamedValues_;
+    std::vector<unsigned long> streamedLengths_;
+
     bool hasIntoElements_;
     bool hasVectorIntoElements_;
     bool hasUseElements_;
@@ -203,6 +280,19 @@ struct mysql_statement_backend : details::statement_backend
 
     typedef std::map<std::string, char **> UseByNameBuffersMap;
     UseByNameBuffersMap useByNameBuffers_;
+
+private:
+    void free_result();
+    void prepare_on_server();
+    exec_fetch_result execute_prepared(int number);
+    void bind_prepared_result();
+    bool fetch_prepared_row();
+    exec_fetch_result fetch_streamed(int number);
+    void execute_bulk_query(std::string const &query,
+        long long &rowsAffectedBulkTemp);
+    void execute_insert_batch(std::string const &batch,
+        std::vector<std::size_t> const &rowStarts,
+        long long &rowsAffectedBulkTemp);
 };
 
 struct mysql_rowid_backend : details::rowid_backend
@@ -229,6 +319,89 @@ struct mysql_blob_backend : details::blob_backend
     mysql_session_backend &session_;
 };
 
+// Values of the rows loaded by mysql_session_backend::load_data(), formatted
+// as expected by LOAD DATA with its default field and line terminators.
+class SOCI_MYSQL_DECL mysql_load_data_row
+{
+public:
+    mysql_load_data_row() : rowStart_(0), columns_(0) {}
+
+    // Add the value of the next column of the row.
+    void add(char value);
+    void add(std::string const & value);
+    void add(short value);
+    void add(int value);
+    void add(long long value);
+    void add(unsigned long long value);
+    void add(double value);
+    void add(std::tm const & value);
+    void add(timestamp value);
+    void add_null();
+
+    template <typename T>
+    mysql_load_data_row & operator<<(T const & value)
+    {
+        add(value);
+        return *this;
+    }
+
+    // Used by the backend to collect the rows of a batch.
+    void begin_row();
+    void end_row();
+    void cancel_row();
+    std::string & data() { return data_; }
+
+private:
+    void next_column();
+
+    std::string data_;
+    std::size_t rowStart_;
+    int columns_;
+};
+
+// Provides the rows for mysql_session_backend::load_data().
+class mysql_load_data_source
+{
+public:
+    virtual ~mysql_load_data_source() {}
+
+    // Add the values of the next row and return true, or return false
+    // without adding anything if there are no more rows.
+    virtual bool next_row(mysql_load_data_row & row) = 0;
+
+    // Called after each batch of rows has been sent to the server, with the
+    // number of rows and bytes in it and the time it took to send it.
+    virtual void on_batch(std::size_t /* rows */, std::size_t /* bytes */,
+        double /* seconds */) {}
+};
+
+// Source loading all the elements of a range, each of them as one row, which
+// requires either a type supported by mysql_load_data_row::add() or a
+// user-defined operator<<(mysql_load_data_row &, T const &).
+template <typename Iterator>
+class mysql_range_load_data_source : public mysql_load_data_source
+{
+public:
+    mysql_range_load_data_source(Iterator begin, Iterator end)
+        : it_(begin), end_(end) {}
+
+    bool next_row(mysql_load_data_row & row) SOCI_OVERRIDE
+    {
+        if (it_ == end_)
+        {
+            return false;
+        }
+
+        row << *it_;
+        ++it_;
+        return true;
+    }
+
+private:
+    Iterator it_;
+    Iterator end_;
+};
+
 struct mysql_session_backend : details::session_backend
 {
     mysql_session_backend(connection_parameters const & parameters);
@@ -253,9 +426,139 @@ struct mysql_session_backend : details::session_backend
     mysql_rowid_backend * make_rowid_backend() SOCI_OVERRIDE;
     mysql_blob_backend * make_blob_backend() SOCI_OVERRIDE;
 
+    // Take a previously prepared statement for the given query out of the
+    // statement cache, returns NULL if there is none.
+    MYSQL_STMT * acquire_statement(std::string const & query);
+
+    // Put the statement back in the cache, closing the least recently used
+    // one if the cache is full.
+    void release_statement(std::string const & query, MYSQL_STMT * stmt);
+
+    // Return the max_allowed_packet value of the server, the maximal size of
+    // a query which can be sent to it.
+    std::size_t get_max_allowed_packet();
+
+    // Load the rows provided by the source into the table using LOAD DATA
+    // LOCAL INFILE without any intermediate file, sending them to the server
+    // in batches of the given number of rows. The columns, if specified, are
+    // a comma-separated list of the table columns in the order of the row
+    // values. Returns the number of loaded rows.
+    //
+    // The session must be opened with "local_infile=1".
+    long long load_data(std::string const & table,
+        mysql_load_data_source & source,
+        std::string const & columns = std::string(),
+        std::size_t batchRows = 1000);
+
+    template <typename Iterator>
+    long long load_data(std::string const & table,
+        Iterator begin, Iterator end,
+        std::string const & columns = std::string())
+    {
+        mysql_range_load_data_source<Iterator> source(begin, end);
+        return load_data(table, source, columns);
+    }
+
     MYSQL *conn_;
+
+    // Server-side prepared statements not used by any SOCI statement, most
+    // recently used first.
+    typedef std::list<std::pair<std::string, MYSQL_STMT *> > statement_cache;
+    statement_cache stmtCache_;
+    std::size_t stmtCacheSize_; // 0 disables server-side prepared statements
+
+    // If true, the rows are retrieved from the server as they are fetched,
+    // using mysql_use_result() instead of mysql_store_result().
+    bool useResult_;
+
+    // If true, the rows of bulk INSERT statements are combined into
+    // multi-row statements, which is only safe for transactional tables.
+    bool batchInsert_;
+
+    std::size_t maxAllowedPacket_; // 0 until retrieved from the server
+
+    // If true, MYSQL_OPT_NONBLOCK was set and mysql_async_query can be used.
+    bool nonblocking_;
 };
 
+#ifdef SOCI_MYSQL_NONBLOCKING
+
+// Query executed using the non-blocking MariaDB API, allowing to execute
+// queries in many sessions from a single thread using an event loop.
+//
+// Each of the functions starting or continuing the operation returns 0 if
+// it has completed or the combination of MYSQL_WAIT_XXX events to wait for
+// on socket() before calling resume() with the events which occurred.
+// Once the query is executed, the rows of its result, if any, are fetched
+// one by one in the same way.
+class SOCI_MYSQL_DECL mysql_async_query
+{
+public:
+    // The session must be opened with "nonblocking=1".
+    mysql_async_query(mysql_session_backend & session,
+        std::string const & query);
+
+    // Completes the pending operation and discards the remaining rows, if
+    // any, blocking until then.
+    ~mysql_async_query();
+
+    // Start executing the query.
+    int start();
+
+    // Continue the pending operation after some of the events waited for
+    // occurred, or MYSQL_WAIT_TIMEOUT if the timeout() expired.
+    int resume(int events);
+
+    // Start fetching the next row, only valid if has_row() is true.
+    int fetch_next();
+
+    // The socket to wait on and the timeout to wait for, in milliseconds,
+    // when MYSQL_WAIT_TIMEOUT is included in the events.
+    my_socket socket() const;
+    unsigned int timeout() const;
+
+    // When the last operation completed, there may be either a row to
+    // process or the query is done.
+    bool done() const { return state_ == state_done; }
+    bool has_row() const { return state_ == state_row; }
+
+    // Accessors for the current row.
+    unsigned int columns() const;
+    bool is_null(unsigned int column) const;
+    std::string get(unsigned int column) const;
+    MYSQL_ROW row() const { return row_; }
+
+    // Number of rows affected by a query not returning any rows.
+    long long affected_rows() const { return affectedRows_; }
+
+private:
+    enum state
+    {
+        state_initial,
+        state_executing,
+        state_fetching,
+        state_row,
+        state_done
+    };
+
+    int start_fetch();
+    int on_executed();
+    int on_fetched();
+
+    mysql_session_backend & session_;
+    std::string const query_;
+    state state_;
+    int queryResult_;
+    MYSQL_RES *result_;
+    MYSQL_ROW row_;
+    long long affectedRows_;
+    int status_; // events waited for by the pending operation
+
+    SOCI_NOT_COPYABLE(mysql_async_query)
+};
+
+#endif // SOCI_MYSQL_NONBLOCKING
+
 
 struct mysql_backend_factory : backend_factory
 {
@@ -95,6 +95,14 @@ public:
     // provide.
     operator const PGresult*() const { return result_; }
 
+    // Gives up the ownership of the result, which must be freed by the caller.
+    PGresult* release()
+    {
+        PGresult* const result = result_;
+        result_ = NULL;
+        return result;
+    }
+
     // Get the associated result (which may be NULL). Unlike the implicit
     // conversion above, this one returns a non-const pointer, so you should be
     // careful to avoid really modifying it.
@@ -185,7 +193,7 @@ struct postgresql_vector_into_type_backend : details::vector_into_type_backend
 struct postgresql_standard_use_type_backend : details::standard_use_type_backend
 {
     postgresql_standard_use_type_backend(postgresql_statement_backend & st)
-        : statement_(st), position_(0), buf_(NULL) {}
+        : statement_(st), position_(0), buf_(NULL), ownBuf_(true) {}
 
     void bind_by_pos(int & position,
         void * data, details::exchange_type type, bool readOnly) SOCI_OVERRIDE;
@@ -208,6 +216,12 @@ struct postgresql_standard_use_type_backend : details::standard_use_type_backend
 private:
     // Allocate buf_ of appropriate size and copy string data into it.
     void copy_from_string(std::string const& s);
+
+    // Make buf_ point to the string data without copying it.
+    void use_string(std::string const& s);
+
+    // False if buf_ points to the data of the used object.
+    bool ownBuf_;
 };
 
 struct postgresql_vector_use_type_backend : details::vector_use_type_backend
@@ -257,7 +271,7 @@ struct postgresql_vector_use_type_backend : details::vector_use_type_backend
 struct postgresql_statement_backend : details::statement_backend
 {
     postgresql_statement_backend(postgresql_session_backend & session,
-        bool single_row_mode);
+        bool single_row_mode, bool cursor_mode);
     ~postgresql_statement_backend() SOCI_OVERRIDE;
 
     void alloc() SOCI_OVERRIDE;
@@ -283,11 +297,22 @@ struct postgresql_statement_backend : details::statement_backend
     postgresql_vector_into_type_backend * make_vector_into_type_backend() SOCI_OVERRIDE;
     postgresql_vector_use_type_backend * make_vector_use_type_backend() SOCI_OVERRIDE;
 
+    // helper for the single-row mode
+    void fetch_single_rows(int number);
+
+    // helpers for the cursor mode
+    void declare_cursor(std::vector<char *> & paramValues);
+    void fetch_from_cursor(int number);
+    void close_cursor();
+
     postgresql_session_backend & session_;
 
     bool single_row_mode_;
+    bool cursor_mode_;
 
     details::postgresql_result result_;
+    details::postgresql_result describeResult_; // columns of the prepared
+                                                // statement or cursor
     std::string query_;
     details::statement_type stType_;
     std::string statementName_;
@@ -301,6 +326,17 @@ struct postgresql_statement_backend : details::statement_backend
 
     bool justDescribed_; // to optimize row description with immediately
                          // following actual statement execution
+    bool describedForRow_; // the columns were described for defining into
+                           // elements for them
+
+    bool singleRowsDone_;  // all the results were retrieved in single-row mode
+
+    bool isCursorQuery_;   // the query can be used in DECLARE CURSOR
+    bool useCursor_;       // the last execution uses a server-side cursor
+    bool cursorWithHold_;  // the cursor was declared outside of transaction
+    int cursorTransaction_; // session transaction count when it was declared
+    bool cursorExhausted_; // the last FETCH returned all the remaining rows
+    std::string cursorName_; // name of the open cursor, if any
 
     bool hasIntoElements_;
     bool hasVectorIntoElements_;
@@ -365,7 +401,8 @@ struct postgresql_blob_backend : details::blob_backend
 struct postgresql_session_backend : details::session_backend
 {
     postgresql_session_backend(connection_parameters const & parameters,
-        bool single_row_mode);
+        bool single_row_mode, bool cursor_mode,
+        std::size_t deallocate_batch_size);
 
     ~postgresql_session_backend() SOCI_OVERRIDE;
 
@@ -375,7 +412,12 @@ struct postgresql_session_backend : details::session_backend
     void commit() SOCI_OVERRIDE;
     void rollback() SOCI_OVERRIDE;
 
+    // Prepared statements are not deallocated immediately but only when
+    // there are at least deallocate_batch_size_ of them, using a single
+    // query executed just before the next one (or immediately if the batch
+    // size is 0), or together with the end of the current transaction.
     void deallocate_prepared_statement(const std::string & statementName);
+    void deallocate_pending_statements(bool force = false);
 
     bool get_next_sequence_value(session & s,
         std::string const & sequence, long long & value) SOCI_OVERRIDE;
@@ -391,9 +433,22 @@ struct postgresql_session_backend : details::session_backend
     postgresql_blob_backend * make_blob_backend() SOCI_OVERRIDE;
 
     std::string get_next_statement_name();
+    std::string get_next_cursor_name();
+
+    // Execute COMMIT or ROLLBACK, deallocating the pending statements too.
+    void end_transaction(char const * command, char const * errMsg);
+
+    // Return the query deallocating all the pending statements and forget
+    // about them.
+    std::string make_deallocate_query();
 
     int statementCount_;
+    int cursorCount_;
+    int transactionCount_; // incremented when a transaction begins or ends
     bool single_row_mode_;
+    bool cursor_mode_;
+    std::size_t deallocate_batch_size_;
+    std::vector<std::string> pendingDeallocations_;
     PGconn * conn_;
 };
 
@@ -51,7 +51,10 @@ enum exchange_type
     x_blob,
 
     x_xmltype,
-    x_longstring
+    x_longstring,
+
+    x_timestamp,
+    x_stringref
 };
 
 // type of statement (used for optimizing statement preparation)
@@ -32,6 +32,7 @@
 #include "soci/session.h"
 #include "soci/soci-backend.h"
 #include "soci/statement.h"
+#include "soci/timestamp.h"
 #include "soci/transaction.h"
 #include "soci/type-conversion.h"
 #include "soci/type-conversion-traits.h"
@@ -24,8 +24,15 @@
 #endif
 
 #include <cstdarg>
+#include <ctime>
+#include <exception>
+#include <list>
+#include <new>
+#include <string>
+#include <utility>
 #include <vector>
 #include <soci/soci-backend.h>
+#include <soci/connection-pool.h>
 
 // Disable flood of nonsense warnings generated for SQLite
 #ifdef _MSC_VER
@@ -135,6 +142,7 @@ struct sqlite3_standard_use_type_backend : details::standard_use_type_backend
     details::exchange_type type_;   // type of data_
     int position_;                  // binding position
     std::string name_;              // binding name
+    char dateBuf_[27];              // std::tm or timestamp formatted as text
 };
 
 struct sqlite3_vector_use_type_backend : details::vector_use_type_backend
@@ -161,6 +169,7 @@ struct sqlite3_vector_use_type_backend : details::vector_use_type_backend
     details::exchange_type type_;
     int position_;
     std::string name_;
+    std::vector<char> dateBuf_; // formatted dates of all rows
 };
 
 struct sqlite3_column_buffer
@@ -187,8 +196,53 @@ struct sqlite3_column
     };
 };
 
-typedef std::vector<sqlite3_column> sqlite3_row;
-typedef std::vector<sqlite3_row> sqlite3_recordset;
+// Rows of columns stored contiguously, row by row.
+class sqlite3_recordset
+{
+public:
+    sqlite3_recordset() : rows_(0), columns_(0) {}
+
+    // changes the dimensions preserving the existing columns values
+    void resize(std::size_t rows, std::size_t columns);
+
+    std::size_t size() const { return rows_; }
+    std::size_t columns() const { return columns_; }
+    bool empty() const { return rows_ == 0; }
+
+    sqlite3_column * operator[](std::size_t row)
+    { return &cells_[row * columns_]; }
+    sqlite3_column const * operator[](std::size_t row) const
+    { return &cells_[row * columns_]; }
+
+private:
+    std::size_t rows_;
+    std::size_t columns_;
+    std::vector<sqlite3_column> cells_;
+};
+
+// Bump allocator holding the variable-length values of the fetched rows, all
+// of them are released at once before loading the next rows.
+class sqlite3_arena
+{
+public:
+    sqlite3_arena() : used_(0) {}
+    ~sqlite3_arena();
+
+    char * allocate(std::size_t size);
+    void reset();
+
+private:
+    struct block
+    {
+        char * data_;
+        std::size_t size_;
+    };
+
+    std::vector<block> blocks_;
+    std::size_t used_; // in the last block
+
+    SOCI_NOT_COPYABLE(sqlite3_arena)
+};
 
 
 struct sqlite3_column_info
@@ -230,7 +284,9 @@ struct sqlite3_statement_backend : details::statement_backend
 
     sqlite3_session_backend &session_;
     sqlite_api::sqlite3_stmt *stmt_;
+    std::string query_; // text stmt_ was prepared from, used as cache key
     sqlite3_recordset dataCache_;
+    sqlite3_arena dataArena_; // strings and blobs of dataCache_
     sqlite3_recordset useData_;
     bool databaseReady_;
     bool boundByName_;
@@ -264,11 +320,25 @@ struct sqlite3_blob_backend : details::blob_backend
     std::size_t get_len() SOCI_OVERRIDE;
     std::size_t read(std::size_t offset, char *buf,
                              std::size_t toRead) SOCI_OVERRIDE;
+    std::size_t read_from_start(char *buf, std::size_t toRead,
+                             std::size_t offset) SOCI_OVERRIDE;
     std::size_t write(std::size_t offset, char const *buf,
                               std::size_t toWrite) SOCI_OVERRIDE;
+    std::size_t write_from_start(char const *buf, std::size_t toWrite,
+                              std::size_t offset) SOCI_OVERRIDE;
     std::size_t append(char const *buf, std::size_t toWrite) SOCI_OVERRIDE;
     void trim(std::size_t newLen) SOCI_OVERRIDE;
 
+    // Access the value stored in the given row of the table directly in the
+    // database instead of keeping a copy of it in memory. The size of the
+    // value can't be changed while it is open, so append() and trim() can't
+    // be used, but it can be read and written in chunks of any size.
+    void open(std::string const &table, std::string const &column,
+              long long rowid, bool readWrite = false,
+              std::string const &dbname = "main");
+    void close();
+    bool is_open() const { return handle_ != 0; }
+
     sqlite3_session_backend &session_;
 
     std::size_t set_data(char const *buf, std::size_t toWrite);
@@ -277,8 +347,227 @@ struct sqlite3_blob_backend : details::blob_backend
 private:
     char *buf_;
     size_t len_;
+    sqlite_api::sqlite3_blob *handle_; // only if open() was called
+};
+
+// Callback notified about the progress of the backup operations.
+class sqlite3_backup_callback
+{
+public:
+    virtual ~sqlite3_backup_callback() {}
+
+    // Called after copying each chunk of pages, return false to abort.
+    virtual bool on_progress(int remainingPages, int totalPages) = 0;
 };
 
+// Arguments of a user-defined function, see
+// sqlite3_session_backend::create_function().
+class SOCI_SQLITE3_DECL sqlite3_function_args
+{
+public:
+    sqlite3_function_args(int argc, sqlite_api::sqlite3_value **argv)
+        : argc_(argc), argv_(argv) {}
+
+    int size() const { return argc_; }
+    bool is_null(int pos) const;
+
+    // Supported types are int, long long, unsigned long long, double,
+    // std::string and std::tm, the argument is converted to the given type
+    // as SQLite does it.
+    template <typename T>
+    T get(int pos) const
+    {
+        T value;
+        get_value(pos, value);
+        return value;
+    }
+
+    sqlite_api::sqlite3_value * get_native(int pos) const;
+
+private:
+    void get_value(int pos, int &value) const;
+    void get_value(int pos, long long &value) const;
+    void get_value(int pos, unsigned long long &value) const;
+    void get_value(int pos, double &value) const;
+    void get_value(int pos, std::string &value) const;
+    void get_value(int pos, std::tm &value) const;
+
+    int argc_;
+    sqlite_api::sqlite3_value **argv_;
+};
+
+// Result of a user-defined function, NULL if it's not set.
+class SOCI_SQLITE3_DECL sqlite3_function_result
+{
+public:
+    explicit sqlite3_function_result(sqlite_api::sqlite3_context *ctx)
+        : ctx_(ctx) {}
+
+    void set(int value);
+    void set(long long value);
+    void set(unsigned long long value);
+    void set(double value);
+    void set(std::string const &value);
+    void set(char const *value);
+    void set(std::tm const &value);
+    void set_null();
+    void set_error(std::string const &message);
+
+    sqlite_api::sqlite3_context * get_native() const { return ctx_; }
+
+private:
+    sqlite_api::sqlite3_context *ctx_;
+};
+
+namespace details
+{
+
+// Adapters calling the C++ objects from SQLite callbacks, errors are
+// reported as SQL errors as exceptions can't be thrown through SQLite.
+
+template <typename F>
+struct sqlite3_function_adapter
+{
+    static void call(sqlite_api::sqlite3_context *ctx,
+                     int argc, sqlite_api::sqlite3_value **argv)
+    {
+        F &f = *static_cast<F *>(sqlite_api::sqlite3_user_data(ctx));
+        sqlite3_function_result result(ctx);
+        try
+        {
+            f(sqlite3_function_args(argc, argv), result);
+        }
+        catch (std::exception const &e)
+        {
+            result.set_error(e.what());
+        }
+        catch (...)
+        {
+            result.set_error("Unknown error in user-defined function.");
+        }
+    }
+
+    static void destroy(void *f)
+    {
+        delete static_cast<F *>(f);
+    }
+};
+
+template <typename A>
+struct sqlite3_aggregate_adapter
+{
+    // The aggregate context only stores the pointer to the object which is
+    // created by the first step and destroyed by the final call.
+    static A * get(sqlite_api::sqlite3_context *ctx)
+    {
+        A **p = static_cast<A **>(
+            sqlite_api::sqlite3_aggregate_context(ctx, sizeof(A *)));
+        if (p == NULL)
+            throw std::bad_alloc();
+        if (*p == NULL)
+            *p = new A();
+        return *p;
+    }
+
+    static void step(sqlite_api::sqlite3_context *ctx,
+                     int argc, sqlite_api::sqlite3_value **argv)
+    {
+        try
+        {
+            get(ctx)->step(sqlite3_function_args(argc, argv));
+        }
+        catch (std::bad_alloc const &)
+        {
+            sqlite_api::sqlite3_result_error_nomem(ctx);
+        }
+        catch (std::exception const &e)
+        {
+            sqlite3_function_result(ctx).set_error(e.what());
+        }
+        catch (...)
+        {
+            sqlite3_function_result(ctx).set_error(
+                "Unknown error in user-defined aggregate.");
+        }
+    }
+
+    static void inverse(sqlite_api::sqlite3_context *ctx,
+                        int argc, sqlite_api::sqlite3_value **argv)
+    {
+        try
+        {
+            get(ctx)->inverse(sqlite3_function_args(argc, argv));
+        }
+        catch (std::bad_alloc const &)
+        {
+            sqlite_api::sqlite3_result_error_nomem(ctx);
+        }
+        catch (std::exception const &e)
+        {
+            sqlite3_function_result(ctx).set_error(e.what());
+        }
+        catch (...)
+        {
+            sqlite3_function_result(ctx).set_error(
+                "Unknown error in user-defined aggregate.");
+        }
+    }
+
+    static void value(sqlite_api::sqlite3_context *ctx)
+    {
+        sqlite3_function_result result(ctx);
+        try
+        {
+            get(ctx)->value(result);
+        }
+        catch (std::bad_alloc const &)
+        {
+            sqlite_api::sqlite3_result_error_nomem(ctx);
+        }
+        catch (std::exception const &e)
+        {
+            result.set_error(e.what());
+        }
+        catch (...)
+        {
+            result.set_error("Unknown error in user-defined aggregate.");
+        }
+    }
+
+    static void final(sqlite_api::sqlite3_context *ctx)
+    {
+        // there is no context if step() was never called, i.e. no rows
+        A **p = static_cast<A **>(sqlite_api::sqlite3_aggregate_context(ctx, 0));
+        A *a = p ? *p : NULL;
+
+        sqlite3_function_result result(ctx);
+        try
+        {
+            if (a)
+            {
+                a->final(result);
+            }
+            else
+            {
+                A empty;
+                empty.final(result);
+            }
+        }
+        catch (std::exception const &e)
+        {
+            result.set_error(e.what());
+        }
+        catch (...)
+        {
+            result.set_error("Unknown error in user-defined aggregate.");
+        }
+
+        delete a;
+    }
+};
+
+} // namespace details
+
 struct sqlite3_session_backend : details::session_backend
 {
     sqlite3_session_backend(connection_parameters const & parameters);
@@ -302,6 +591,75 @@ struct sqlite3_session_backend : details::session_backend
 
     void clean_up();
 
+    // Take a previously prepared statement for the given query out of the
+    // statement cache, returns NULL if there is none.
+    sqlite_api::sqlite3_stmt * acquire_statement(std::string const & query);
+
+    // Reset the statement and put it back in the cache (or finalize it if
+    // caching is disabled).
+    void release_statement(std::string const & query,
+        sqlite_api::sqlite3_stmt * stmt);
+
+    // Replace the contents of this database with those of the given file
+    // or copy them to it using the online backup API, copying the given
+    // number of pages at a time (all of them by default).
+    void load_from(std::string const & filename, int pagesPerStep = -1,
+        sqlite3_backup_callback * callback = NULL);
+    void save_to(std::string const & filename, int pagesPerStep = -1,
+        sqlite3_backup_callback * callback = NULL);
+
+    // Register a function callable from SQL taking the given number of
+    // arguments (or any number if it's -1). The function object is copied
+    // and called as f(sqlite3_function_args const&, sqlite3_function_result&).
+    // It must only be declared deterministic if it always returns the same
+    // result for the same arguments, which allows SQLite to optimize it.
+    template <typename F>
+    void create_function(std::string const & name, int nArgs, F f,
+        bool deterministic = false)
+    {
+        int const res = sqlite_api::sqlite3_create_function_v2(conn_,
+            name.c_str(), nArgs, get_function_flags(deterministic),
+            new F(f),
+            &details::sqlite3_function_adapter<F>::call, NULL, NULL,
+            &details::sqlite3_function_adapter<F>::destroy);
+        check_create_function(res, name);
+    }
+
+    // Register an aggregate function: a new object of type A is created for
+    // each group, its step(sqlite3_function_args const&) is called for each
+    // row and final(sqlite3_function_result&) once at the end.
+    template <typename A>
+    void create_aggregate(std::string const & name, int nArgs,
+        bool deterministic = false)
+    {
+        int const res = sqlite_api::sqlite3_create_function_v2(conn_,
+            name.c_str(), nArgs, get_function_flags(deterministic), NULL,
+            NULL,
+            &details::sqlite3_aggregate_adapter<A>::step,
+            &details::sqlite3_aggregate_adapter<A>::final,
+            NULL);
+        check_create_function(res, name);
+    }
+
+#if SQLITE_VERSION_NUMBER >= 3025000
+    // Register an aggregate which can also be used as a window function, A
+    // must additionally provide inverse(sqlite3_function_args const&),
+    // removing a row from the window, and value(sqlite3_function_result&).
+    template <typename A>
+    void create_window_function(std::string const & name, int nArgs,
+        bool deterministic = false)
+    {
+        int const res = sqlite_api::sqlite3_create_window_function(conn_,
+            name.c_str(), nArgs, get_function_flags(deterministic), NULL,
+            &details::sqlite3_aggregate_adapter<A>::step,
+            &details::sqlite3_aggregate_adapter<A>::final,
+            &details::sqlite3_aggregate_adapter<A>::value,
+            &details::sqlite3_aggregate_adapter<A>::inverse,
+            NULL);
+        check_create_function(res, name);
+    }
+#endif // SQLITE_VERSION_NUMBER >= 3025000
+
     sqlite3_statement_backend * make_statement_backend() SOCI_OVERRIDE;
     sqlite3_rowid_backend * make_rowid_backend() SOCI_OVERRIDE;
     sqlite3_blob_backend * make_blob_backend() SOCI_OVERRIDE;
@@ -333,6 +691,17 @@ struct sqlite3_session_backend : details::session_backend
 
     }
     sqlite_api::sqlite3 *conn_;
+
+    static int get_function_flags(bool deterministic);
+    void check_create_function(int res, std::string const & name);
+
+    // Statements not used by any SOCI statement, most recently used first.
+    typedef std::list<std::pair<std::string, sqlite_api::sqlite3_stmt *> >
+        statement_cache;
+    statement_cache stmtCache_;
+    std::size_t stmtCacheSize_; // 0 disables the cache
+
+    int busyTimeout_; // in milliseconds, also used for backups
 };
 
 struct sqlite3_backend_factory : backend_factory
@@ -344,6 +713,31 @@ struct sqlite3_backend_factory : backend_factory
 
 extern SOCI_SQLITE3_DECL sqlite3_backend_factory const sqlite3;
 
+// Connections to the same database file in WAL journal mode: a single one
+// for modifying the database and several read-only ones which can be used
+// concurrently by different threads without blocking each other or the
+// writer.
+class SOCI_SQLITE3_DECL sqlite3_wal_pool
+{
+public:
+    // The options are added to the connection string of all the sessions,
+    // e.g. "timeout=5 mmap_size=268435456".
+    sqlite3_wal_pool(std::string const & dbname, std::size_t readers,
+                     std::string const & options = std::string());
+
+    connection_pool & writer() { return writer_; }
+    connection_pool & readers() { return readers_; }
+
+    // Return readers() for select statements and writer() for all the others.
+    connection_pool & route(std::string const & query);
+
+private:
+    connection_pool writer_;
+    connection_pool readers_;
+
+    SOCI_NOT_COPYABLE(sqlite3_wal_pool)
+};
+
 extern "C"
 {
 
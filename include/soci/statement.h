@@ -44,6 +44,9 @@ public:
     void alloc();
     void bind(values & v);
 
+    // checks if the query refers to the given named placeholder
+    bool has_placeholder(std::string const & name) const;
+
     void exchange(into_type_ptr const & i) { intos_.exchange(i); }
     template <typename T, typename Indicator>
     void exchange(into_container<T, Indicator> const &ic)
@@ -0,0 +1,40 @@
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SOCI_TIMESTAMP_H_INCLUDED
+#define SOCI_TIMESTAMP_H_INCLUDED
+
+#include "soci/soci-platform.h"
+// std
+#include <cstddef>
+#include <ctime>
+
+namespace soci
+{
+
+// Compact representation of date and time values with microsecond precision,
+// which can be used with 'into' and 'use' elements instead of std::tm to avoid
+// the overhead of converting to and from it.
+//
+// The value is the number of microseconds since 1970-01-01 00:00:00. Just as
+// with std::tm, the date and time are used as they are and are not converted
+// to or from UTC.
+struct timestamp
+{
+    timestamp() : value(0) {}
+    explicit timestamp(long long microseconds) : value(microseconds) {}
+
+    long long value;
+};
+
+// Conversions between timestamp and std::tm. The fractional part of seconds
+// is lost when converting to std::tm unless a pointer to store it is given.
+SOCI_DECL timestamp timestamp_from_tm(std::tm const & t, int microseconds = 0);
+SOCI_DECL std::tm timestamp_to_tm(timestamp ts, int * microseconds = NULL);
+
+} // namespace soci
+
+#endif // SOCI_TIMESTAMP_H_INCLUDED
@@ -234,6 +234,14 @@ public:
         ind_.resize(actual_size);
     }
 
+    // used by the bulk ORM elements, which convert all the rows from the
+    // same object instead of filling the vector of base values
+    void convert_row_from_base(
+        typename type_conversion<T>::base_type const & v, std::size_t i)
+    {
+        type_conversion<T>::from_base(v, ind_[i], value_[i]);
+    }
+
 private:
     void convert_from_base() SOCI_OVERRIDE
     {
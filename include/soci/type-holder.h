@@ -9,7 +9,9 @@
 #define SOCI_TYPE_HOLDER_H_INCLUDED
 
 #include "soci/soci-platform.h"
+#include "soci/timestamp.h"
 // std
+#include <ctime>
 #include <typeinfo>
 
 namespace soci
@@ -63,6 +65,27 @@ private:
     T * t_;
 };
 
+// The date/time values are always stored as std::tm in the rows, but can be
+// retrieved as timestamps too (without the fractional part of seconds).
+template<>
+inline timestamp holder::get<timestamp>()
+{
+    if (type_holder<std::tm>* p = dynamic_cast<type_holder<std::tm> *>(this))
+    {
+        return timestamp_from_tm(p->value<std::tm>());
+    }
+
+    type_holder<timestamp>* p = dynamic_cast<type_holder<timestamp> *>(this);
+    if (p)
+    {
+        return p->value<timestamp>();
+    }
+    else
+    {
+        throw std::bad_cast();
+    }
+}
+
 } // namespace details
 
 } // namespace soci
@@ -8,6 +8,10 @@
 #ifndef SOCI_TYPE_WRAPPERS_H_INCLUDED
 #define SOCI_TYPE_WRAPPERS_H_INCLUDED
 
+// std
+#include <cstddef>
+#include <string>
+
 namespace soci
 {
 
@@ -28,6 +32,27 @@ struct long_string
     std::string value;
 };
 
+// This wrapper can be used only with 'into' elements to access the string
+// value directly in the buffer of the backend, without copying it. The data
+// is not NUL-terminated and remains valid only until the next fetch() or
+// execute() of the same statement, so it must be copied, e.g. using str(),
+// to be kept for longer than that.
+//
+// It is currently supported by the PostgreSQL, MySQL, SQLite3 and ODBC
+// backends only and vectors of it can be used with the first two of them.
+struct string_ref
+{
+    string_ref() : data(NULL), size(0) {}
+
+    std::string str() const
+    {
+        return data != NULL ? std::string(data, size) : std::string();
+    }
+
+    char const * data;
+    std::size_t size;
+};
+
 } // namespace soci
 
 #endif // SOCI_TYPE_WRAPPERS_H_INCLUDED
@@ -104,12 +104,43 @@ private:
     SOCI_NOT_COPYABLE(use_type)
 };
 
-// this is not supposed to be used - no support for bulk ORM
+class values_use_column;
+
+// Bulk ORM: the values of all rows are converted using type_conversion and
+// then gathered into one vector per field, which are bound as usual vector
+// use elements. The layout of the fields is taken from the first row.
 template <>
-class use_type<std::vector<values> >
+class SOCI_DECL use_type<std::vector<values> > : public use_type_base
 {
+public:
+    use_type(std::vector<values> & v, std::vector<indicator> & /* ind */,
+        std::size_t begin, std::size_t * end,
+        std::string const & name = std::string());
+
+    ~use_type() SOCI_OVERRIDE;
+
+    void bind(details::statement_impl & st, int & position) SOCI_OVERRIDE;
+    std::string get_name() const SOCI_OVERRIDE;
+    void dump_value(std::ostream& os) const SOCI_OVERRIDE;
+    void pre_exec(int num) SOCI_OVERRIDE;
+    void pre_use() SOCI_OVERRIDE;
+    void post_use(bool gotData) SOCI_OVERRIDE;
+    void clean_up() SOCI_OVERRIDE;
+    std::size_t size() const SOCI_OVERRIDE;
+
+    // used only to re-dispatch to the derived class generated by
+    // user conversions
+    virtual void convert_to_base() {}
+
 private:
-    use_type();
+    void gather();
+    void release_values();
+
+    std::vector<values> & v_;
+    std::vector<values_use_column *> columns_;
+    std::size_t rows_;
+
+    SOCI_NOT_COPYABLE(use_type)
 };
 
 template <>
@@ -135,12 +166,45 @@ private:
     SOCI_NOT_COPYABLE(into_type)
 };
 
-// this is not supposed to be used - no support for bulk ORM
+class values_into_column;
+
+// Bulk ORM: the columns of the result set are described once and fetched
+// into one vector per column, the values of each fetched row are then copied
+// in turn into the same values object for the conversion into the user type.
 template <>
-class into_type<std::vector<values> >
+class SOCI_DECL into_type<std::vector<values> > : public into_type_base
 {
+public:
+    into_type(std::vector<values> & v, std::vector<indicator> & ind,
+        std::size_t begin, std::size_t * end);
+
+    ~into_type() SOCI_OVERRIDE;
+
+    void define(statement_impl & st, int & position) SOCI_OVERRIDE;
+    void pre_exec(int num) SOCI_OVERRIDE;
+    void pre_fetch() SOCI_OVERRIDE;
+    void post_fetch(bool gotData, bool calledFromFetch) SOCI_OVERRIDE;
+    void clean_up() SOCI_OVERRIDE;
+    std::size_t size() const SOCI_OVERRIDE;
+    void resize(std::size_t sz) SOCI_OVERRIDE;
+
+    // used only to re-dispatch to the derived class generated by
+    // user conversions
+    virtual void convert_from_base() {}
+    virtual void convert_row_from_base(values const & /* v */,
+        std::size_t /* i */) {}
+
 private:
-    into_type();
+    void describe();
+
+    std::vector<values> & v_;
+    std::vector<indicator> & ind_;
+    statement_impl * st_;
+    int position_;
+    std::vector<values_into_column *> columns_;
+    values current_; // the row being converted
+
+    SOCI_NOT_COPYABLE(into_type)
 };
 
 } // namespace details
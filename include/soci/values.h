@@ -18,6 +18,9 @@
 #include <string>
 #include <utility>
 #include <vector>
+#ifdef SOCI_HAVE_CXX11
+#include <type_traits>
+#endif
 
 namespace soci
 {
@@ -34,11 +37,39 @@ public:
 template <typename T>
 struct copy_holder : public copy_base
 {
+    copy_holder() : value_() {}
     copy_holder(T const & v) : value_(v) {}
+#ifdef SOCI_HAVE_CXX11
+    copy_holder(T && v) : value_(std::move(v)) {}
+#endif
 
     T value_;
 };
 
+#ifdef SOCI_HAVE_CXX11
+
+// Helpers for values::set() taking an rvalue: the value is moved into its
+// storage if no conversion is needed, avoiding copying large strings.
+template <typename T>
+typename std::enable_if<
+    std::is_same<typename type_conversion<T>::base_type, T>::value>::type
+move_to_base(T && in, T & out, indicator & ind)
+{
+    out = std::move(in);
+    ind = i_ok;
+}
+
+template <typename T>
+typename std::enable_if<
+    !std::is_same<typename type_conversion<T>::base_type, T>::value>::type
+move_to_base(T && in, typename type_conversion<T>::base_type & out,
+    indicator & ind)
+{
+    type_conversion<T>::to_base(in, out, ind);
+}
+
+#endif // SOCI_HAVE_CXX11
+
 } // namespace details
 
 class SOCI_DECL values
@@ -46,6 +77,8 @@ class SOCI_DECL values
     friend class details::statement_impl;
     friend class details::into_type<values>;
     friend class details::use_type<values>;
+    friend class details::into_type<std::vector<values> >;
+    friend class details::use_type<std::vector<values> >;
 
 public:
 
@@ -162,6 +195,8 @@ public:
         }
     }
 
+    // The value is converted directly into the storage used for binding it,
+    // so it is copied only once.
     template <typename T>
     void set(std::string const & name, T const & value, indicator indic = i_ok)
     {
@@ -173,13 +208,15 @@ public:
             indicator * pind = new indicator(indic);
             indicators_.push_back(pind);
 
-            base_type baseValue;
-            type_conversion<T>::to_base(value, baseValue, *pind);
-
             details::copy_holder<base_type> * pcopy =
-                    new details::copy_holder<base_type>(baseValue);
+                    new details::copy_holder<base_type>();
             deepCopies_.push_back(pcopy);
 
+            if (indic == i_ok)
+            {
+                type_conversion<T>::to_base(value, pcopy->value_, *pind);
+            }
+
             uses_.push_back(new details::use_type<base_type>(
                     pcopy->value_, *pind, name));
         }
@@ -204,16 +241,81 @@ public:
         indicators_.push_back(pind);
 
         typedef typename type_conversion<T>::base_type base_type;
-        base_type baseValue;
-        type_conversion<T>::to_base(value, baseValue, *pind);
+        details::copy_holder<base_type> * pcopy =
+            new details::copy_holder<base_type>();
+        deepCopies_.push_back(pcopy);
+
+        if (indic == i_ok)
+        {
+            type_conversion<T>::to_base(value, pcopy->value_, *pind);
+        }
+
+        uses_.push_back(new details::use_type<base_type>(
+                pcopy->value_, *pind));
+    }
+
+#ifdef SOCI_HAVE_CXX11
+    // Overloads for temporary values, which are moved instead of being copied
+    // when they don't need to be converted.
+    template <typename T, typename = typename std::enable_if<
+        !std::is_lvalue_reference<T>::value && !std::is_const<T>::value>::type>
+    void set(std::string const & name, T && value, indicator indic = i_ok)
+    {
+        typedef typename type_conversion<T>::base_type base_type;
+        if (index_.find(name) == index_.end())
+        {
+            index_.insert(std::make_pair(name, uses_.size()));
+
+            indicator * pind = new indicator(indic);
+            indicators_.push_back(pind);
+
+            details::copy_holder<base_type> * pcopy =
+                    new details::copy_holder<base_type>();
+            deepCopies_.push_back(pcopy);
+
+            if (indic == i_ok)
+            {
+                details::move_to_base(std::move(value), pcopy->value_, *pind);
+            }
 
+            uses_.push_back(new details::use_type<base_type>(
+                    pcopy->value_, *pind, name));
+        }
+        else
+        {
+            size_t index = index_.find(name)->second;
+            *indicators_[index] = indic;
+            if (indic == i_ok)
+            {
+                details::move_to_base(
+                        std::move(value),
+                        static_cast<details::copy_holder<base_type>*>(deepCopies_[index])->value_,
+                        *indicators_[index]);
+            }
+        }
+    }
+
+    template <typename T, typename = typename std::enable_if<
+        !std::is_lvalue_reference<T>::value && !std::is_const<T>::value>::type>
+    void set(T && value, indicator indic = i_ok)
+    {
+        indicator * pind = new indicator(indic);
+        indicators_.push_back(pind);
+
+        typedef typename type_conversion<T>::base_type base_type;
         details::copy_holder<base_type> * pcopy =
-            new details::copy_holder<base_type>(baseValue);
+            new details::copy_holder<base_type>();
         deepCopies_.push_back(pcopy);
 
+        if (indic == i_ok)
+        {
+            details::move_to_base(std::move(value), pcopy->value_, *pind);
+        }
+
         uses_.push_back(new details::use_type<base_type>(
                 pcopy->value_, *pind));
     }
+#endif // SOCI_HAVE_CXX11
 
     template <typename T>
     values & operator<<(T const & value)
@@ -344,6 +446,31 @@ private:
             delete deepCopies_[i];
         }
     }
+
+    // this is called by the bulk ORM elements, which never bind the uses of
+    // the values they create, to make the object reusable for the next row
+    void reset()
+    {
+        delete row_;
+        row_ = NULL;
+
+        for (std::size_t i = 0; i != uses_.size(); ++i)
+        {
+            delete uses_[i];
+            delete indicators_[i];
+        }
+
+        for (std::size_t i = 0; i != deepCopies_.size(); ++i)
+        {
+            delete deepCopies_[i];
+        }
+
+        uses_.clear();
+        indicators_.clear();
+        index_.clear();
+        deepCopies_.clear();
+        currentPos_ = 0;
+    }
 };
 
 } // namespace soci
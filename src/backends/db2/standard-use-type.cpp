@@ -101,6 +101,8 @@ void *db2_standard_use_type_backend::prepare_for_bind(
     case x_blob:
     case x_xmltype:
     case x_longstring:
+    case x_timestamp:
+    case x_stringref:
         break;
     case x_statement:
     case x_rowid:
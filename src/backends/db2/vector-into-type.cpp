@@ -151,6 +151,8 @@ void db2_vector_into_type_backend::define_by_pos(
     case x_blob:
     case x_xmltype:
     case x_longstring:
+    case x_timestamp:
+    case x_stringref:
         throw soci_error("Unsupported type for vector into parameter");
     }
 
@@ -344,6 +346,8 @@ void db2_vector_into_type_backend::resize(std::size_t sz)
     case x_blob:      break; // not supported
     case x_xmltype:   break; // not supported
     case x_longstring:break; // not supported
+    case x_timestamp: break; // not supported
+    case x_stringref: break; // not supported
     }
 }
 
@@ -412,6 +416,8 @@ std::size_t db2_vector_into_type_backend::size()
     case x_blob:      break; // not supported
     case x_xmltype:   break; // not supported
     case x_longstring:break; // not supported
+    case x_timestamp: break; // not supported
+    case x_stringref: break; // not supported
     }
 
     return sz;
@@ -183,6 +183,8 @@ void db2_vector_use_type_backend::prepare_for_bind(void *&data, SQLUINTEGER &siz
     case x_blob:      break; // not supported
     case x_xmltype:   break; // not supported
     case x_longstring:break; // not supported
+    case x_timestamp: break; // not supported
+    case x_stringref: break; // not supported
     }
 
     colSize = size;
@@ -387,6 +389,8 @@ std::size_t db2_vector_use_type_backend::size()
     case x_blob:      break; // not supported
     case x_xmltype:   break; // not supported
     case x_longstring:break; // not supported
+    case x_timestamp: break; // not supported
+    case x_stringref: break; // not supported
     }
 
     return sz;
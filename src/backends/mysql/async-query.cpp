@@ -0,0 +1,283 @@
+//
+// Copyright (C) 2004-2006 Maciej Sobczak, Stephen Hutton
+// MySQL backend copyright (C) 2006 Pawel Aleksander Fedorynski
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define SOCI_MYSQL_SOURCE
+#include "soci/mysql/soci-mysql.h"
+
+#ifdef SOCI_MYSQL_NONBLOCKING
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
+#include <cerrno>
+
+using namespace soci;
+
+namespace // anonymous
+{
+
+// Wait for the events indicated by the status returned by one of the
+// non-blocking functions and return those which occurred.
+int wait_for_events(my_socket sock, int status, unsigned int timeout)
+{
+#ifdef _WIN32
+    fd_set readFds, writeFds, exceptFds;
+    FD_ZERO(&readFds);
+    FD_ZERO(&writeFds);
+    FD_ZERO(&exceptFds);
+    if (status & MYSQL_WAIT_READ)
+        FD_SET(sock, &readFds);
+    if (status & MYSQL_WAIT_WRITE)
+        FD_SET(sock, &writeFds);
+    if (status & MYSQL_WAIT_EXCEPT)
+        FD_SET(sock, &exceptFds);
+
+    timeval tv;
+    tv.tv_sec = timeout / 1000;
+    tv.tv_usec = (timeout % 1000) * 1000;
+
+    int const res = select(0, &readFds, &writeFds, &exceptFds,
+        status & MYSQL_WAIT_TIMEOUT ? &tv : NULL);
+    if (res < 0)
+    {
+        throw soci_error("Failed to wait for the asynchronous query.");
+    }
+
+    int events = res == 0 ? MYSQL_WAIT_TIMEOUT : 0;
+    if (FD_ISSET(sock, &readFds))
+        events |= MYSQL_WAIT_READ;
+    if (FD_ISSET(sock, &writeFds))
+        events |= MYSQL_WAIT_WRITE;
+    if (FD_ISSET(sock, &exceptFds))
+        events |= MYSQL_WAIT_EXCEPT;
+#else
+    pollfd pfd;
+    pfd.fd = sock;
+    pfd.events = 0;
+    pfd.revents = 0;
+    if (status & MYSQL_WAIT_READ)
+        pfd.events |= POLLIN;
+    if (status & MYSQL_WAIT_WRITE)
+        pfd.events |= POLLOUT;
+    if (status & MYSQL_WAIT_EXCEPT)
+        pfd.events |= POLLPRI;
+
+    int const pollTimeout = status & MYSQL_WAIT_TIMEOUT
+        ? static_cast<int>(timeout) : -1;
+    int res;
+    do
+    {
+        res = poll(&pfd, 1, pollTimeout);
+    }
+    while (res < 0 && errno == EINTR);
+
+    if (res < 0)
+    {
+        throw soci_error("Failed to wait for the asynchronous query.");
+    }
+
+    int events = res == 0 ? MYSQL_WAIT_TIMEOUT : 0;
+    if (pfd.revents & POLLIN)
+        events |= MYSQL_WAIT_READ;
+    if (pfd.revents & POLLOUT)
+        events |= MYSQL_WAIT_WRITE;
+    if (pfd.revents & POLLPRI)
+        events |= MYSQL_WAIT_EXCEPT;
+#endif
+
+    return events;
+}
+
+} // namespace anonymous
+
+mysql_async_query::mysql_async_query(mysql_session_backend & session,
+    std::string const & query)
+    : session_(session), query_(query), state_(state_initial),
+      queryResult_(0), result_(NULL), row_(NULL), affectedRows_(-1),
+      status_(0)
+{
+    if (!session_.nonblocking_)
+    {
+        throw soci_error("Asynchronous queries can only be used with the "
+            "sessions opened with \"nonblocking=1\".");
+    }
+}
+
+mysql_async_query::~mysql_async_query()
+{
+    // The connection can't be used for anything else until the pending
+    // operation completes and the remaining rows are read, so do it here,
+    // blocking until then.
+    try
+    {
+        while (state_ == state_executing || state_ == state_fetching)
+        {
+            resume(wait_for_events(socket(), status_, timeout()));
+        }
+
+        if (result_ != NULL)
+        {
+            int status = mysql_free_result_start(result_);
+            while (status != 0)
+            {
+                status = mysql_free_result_cont(result_,
+                    wait_for_events(socket(), status, timeout()));
+            }
+        }
+    }
+    catch (...)
+    {
+        // Errors can't be reported from here and, if waiting failed, the
+        // connection remains unusable.
+    }
+}
+
+int mysql_async_query::start()
+{
+    if (state_ != state_initial)
+    {
+        throw soci_error("Asynchronous query was already started.");
+    }
+
+    state_ = state_executing;
+    status_ = mysql_real_query_start(&queryResult_, session_.conn_,
+        query_.c_str(), static_cast<unsigned long>(query_.size()));
+
+    return status_ != 0 ? status_ : on_executed();
+}
+
+int mysql_async_query::resume(int events)
+{
+    switch (state_)
+    {
+    case state_executing:
+        status_ = mysql_real_query_cont(&queryResult_, session_.conn_, events);
+        return status_ != 0 ? status_ : on_executed();
+
+    case state_fetching:
+        status_ = mysql_fetch_row_cont(&row_, result_, events);
+        return status_ != 0 ? status_ : on_fetched();
+
+    default:
+        throw soci_error("No pending asynchronous operation to resume.");
+    }
+}
+
+int mysql_async_query::fetch_next()
+{
+    if (state_ != state_row)
+    {
+        throw soci_error("No row was fetched by the asynchronous query.");
+    }
+
+    return start_fetch();
+}
+
+my_socket mysql_async_query::socket() const
+{
+    return mysql_get_socket(session_.conn_);
+}
+
+unsigned int mysql_async_query::timeout() const
+{
+    return mysql_get_timeout_value_ms(session_.conn_);
+}
+
+unsigned int mysql_async_query::columns() const
+{
+    if (state_ != state_row)
+    {
+        throw soci_error("No row was fetched by the asynchronous query.");
+    }
+
+    return mysql_num_fields(result_);
+}
+
+bool mysql_async_query::is_null(unsigned int column) const
+{
+    if (column >= columns())
+    {
+        throw soci_error("Invalid column index.");
+    }
+
+    return row_[column] == NULL;
+}
+
+std::string mysql_async_query::get(unsigned int column) const
+{
+    if (is_null(column))
+    {
+        throw soci_error("Null value fetched by the asynchronous query.");
+    }
+
+    unsigned long * lengths = mysql_fetch_lengths(result_);
+    return std::string(row_[column], lengths[column]);
+}
+
+int mysql_async_query::start_fetch()
+{
+    state_ = state_fetching;
+    status_ = mysql_fetch_row_start(&row_, result_);
+
+    return status_ != 0 ? status_ : on_fetched();
+}
+
+int mysql_async_query::on_executed()
+{
+    MYSQL * const conn = session_.conn_;
+    if (queryResult_ != 0)
+    {
+        state_ = state_done;
+        throw mysql_soci_error(mysql_error(conn), mysql_errno(conn));
+    }
+
+    if (mysql_field_count(conn) == 0)
+    {
+        affectedRows_ = static_cast<long long>(mysql_affected_rows(conn));
+        state_ = state_done;
+        return 0;
+    }
+
+    // This doesn't perform any I/O, the rows are read when fetching them.
+    result_ = mysql_use_result(conn);
+    if (result_ == NULL)
+    {
+        state_ = state_done;
+        throw mysql_soci_error(mysql_error(conn), mysql_errno(conn));
+    }
+
+    return start_fetch();
+}
+
+int mysql_async_query::on_fetched()
+{
+    if (row_ != NULL)
+    {
+        state_ = state_row;
+        return 0;
+    }
+
+    // Either all rows were fetched, so that freeing the result doesn't
+    // block, or an error occurred.
+    state_ = state_done;
+    MYSQL * const conn = session_.conn_;
+    unsigned int const errNum = mysql_errno(conn);
+    std::string const errMsg = errNum != 0 ? mysql_error(conn) : "";
+
+    mysql_free_result(result_);
+    result_ = NULL;
+
+    if (errNum != 0)
+    {
+        throw mysql_soci_error(errMsg, errNum);
+    }
+
+    return 0;
+}
+
+#endif // SOCI_MYSQL_NONBLOCKING
@@ -51,9 +51,7 @@ bool is_infinity_or_nan(T x)
 template <typename T>
 void parse_num(char const *buf, T &x)
 {
-    std::istringstream iss(buf);
-    iss >> x;
-    if (iss.fail() || (iss.eof() == false))
+    if (cstring_to_integer(buf, x) == false)
     {
         throw soci_error("Cannot convert data.");
     }
@@ -0,0 +1,386 @@
+//
+// Copyright (C) 2004-2006 Maciej Sobczak, Stephen Hutton
+// MySQL backend copyright (C) 2006 Pawel Aleksander Fedorynski
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define SOCI_MYSQL_SOURCE
+#include "soci/mysql/soci-mysql.h"
+#include "common.h"
+#include "soci/soci-platform.h"
+#include "soci-dtocstr.h"
+#include "soci-mktime.h"
+#include <errmsg.h>
+// std
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <limits>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+using namespace soci;
+using namespace soci::details;
+using namespace soci::details::mysql;
+
+void mysql_load_data_row::add(char value)
+{
+    add(std::string(1, value));
+}
+
+void mysql_load_data_row::add(std::string const & value)
+{
+    next_column();
+
+    // LOAD DATA uses backslash as the escape character by default.
+    for (std::string::const_iterator it = value.begin();
+         it != value.end(); ++it)
+    {
+        switch (*it)
+        {
+        case '\\': data_ += "\\\\"; break;
+        case '\t': data_ += "\\t";  break;
+        case '\n': data_ += "\\n";  break;
+        case '\0': data_ += "\\0";  break;
+        default:   data_ += *it;    break;
+        }
+    }
+}
+
+void mysql_load_data_row::add(short value)
+{
+    add(static_cast<int>(value));
+}
+
+void mysql_load_data_row::add(int value)
+{
+    next_column();
+
+    char buf[std::numeric_limits<int>::digits10 + 3];
+    snprintf(buf, sizeof(buf), "%d", value);
+    data_ += buf;
+}
+
+void mysql_load_data_row::add(long long value)
+{
+    next_column();
+
+    char buf[std::numeric_limits<long long>::digits10 + 3];
+    snprintf(buf, sizeof(buf), "%" LL_FMT_FLAGS "d", value);
+    data_ += buf;
+}
+
+void mysql_load_data_row::add(unsigned long long value)
+{
+    next_column();
+
+    char buf[std::numeric_limits<unsigned long long>::digits10 + 3];
+    snprintf(buf, sizeof(buf), "%" LL_FMT_FLAGS "u", value);
+    data_ += buf;
+}
+
+void mysql_load_data_row::add(double value)
+{
+    if (is_infinity_or_nan(value)) {
+        throw soci_error(
+            "Infinity or NaN can't be loaded, they are "
+            "not supported by the MySQL server.");
+    }
+
+    next_column();
+    data_ += double_to_cstring(value);
+}
+
+void mysql_load_data_row::add(std::tm const & value)
+{
+    next_column();
+
+    char buf[80];
+    format_std_tm(buf, sizeof(buf), value);
+    data_ += buf;
+}
+
+void mysql_load_data_row::add(timestamp value)
+{
+    next_column();
+
+    char buf[80];
+    format_timestamp(buf, sizeof(buf), value.value);
+    data_ += buf;
+}
+
+void mysql_load_data_row::add_null()
+{
+    next_column();
+    data_ += "\\N";
+}
+
+void mysql_load_data_row::begin_row()
+{
+    rowStart_ = data_.size();
+    columns_ = 0;
+}
+
+void mysql_load_data_row::end_row()
+{
+    data_ += '\n';
+}
+
+void mysql_load_data_row::cancel_row()
+{
+    data_.resize(rowStart_);
+}
+
+void mysql_load_data_row::next_column()
+{
+    if (columns_++ != 0)
+    {
+        data_ += '\t';
+    }
+}
+
+namespace // anonymous
+{
+
+double get_current_time()
+{
+#ifdef _WIN32
+    return GetTickCount() / 1000.0;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+#endif
+}
+
+// State of the LOAD DATA LOCAL INFILE operation, passed to the callbacks.
+struct load_data_context
+{
+    load_data_context(mysql_load_data_source & source, std::size_t batchRows)
+        : source_(source), batchRows_(batchRows),
+          pos_(0), rows_(0), batchStart_(0), done_(false) {}
+
+    mysql_load_data_source & source_;
+    std::size_t const batchRows_;
+
+    mysql_load_data_row batch_; // formatted rows of the current batch
+    std::size_t pos_;           // part of the batch already sent
+    std::size_t rows_;          // number of rows in the batch
+    double batchStart_;         // time of the first read of the batch
+    bool done_;                 // no more rows in the source
+
+    std::string error_;         // error which happened in the callbacks
+
+    SOCI_NOT_COPYABLE(load_data_context)
+};
+
+int load_data_init(void **ptr, const char * /* filename */, void *userdata)
+{
+    *ptr = userdata;
+    return 0;
+}
+
+// Collect the next batch of rows, return false if there are none.
+bool load_data_next_batch(load_data_context & ctx)
+{
+    std::string & data = ctx.batch_.data();
+    data.clear();
+    ctx.pos_ = 0;
+    ctx.rows_ = 0;
+
+    while (ctx.rows_ != ctx.batchRows_)
+    {
+        ctx.batch_.begin_row();
+        if (!ctx.source_.next_row(ctx.batch_))
+        {
+            ctx.batch_.cancel_row();
+            ctx.done_ = true;
+            break;
+        }
+
+        ctx.batch_.end_row();
+        ++ctx.rows_;
+    }
+
+    return ctx.rows_ != 0;
+}
+
+int load_data_read(void *ptr, char *buf, unsigned int bufLen)
+{
+    load_data_context & ctx = *static_cast<load_data_context *>(ptr);
+
+    try
+    {
+        std::string const & data = ctx.batch_.data();
+        if (ctx.pos_ == data.size())
+        {
+            // The previous batch, if any, has been entirely sent by now, as
+            // the client sends the data of each read before the next one.
+            if (ctx.rows_ != 0)
+            {
+                ctx.source_.on_batch(ctx.rows_, data.size(),
+                    get_current_time() - ctx.batchStart_);
+                ctx.rows_ = 0;
+            }
+
+            if (ctx.done_ || !load_data_next_batch(ctx))
+            {
+                return 0;
+            }
+
+            // Don't count the time spent on formatting the rows.
+            ctx.batchStart_ = get_current_time();
+        }
+
+        std::size_t const len = (std::min)(
+            static_cast<std::size_t>(bufLen), data.size() - ctx.pos_);
+        std::memcpy(buf, data.data() + ctx.pos_, len);
+        ctx.pos_ += len;
+
+        return static_cast<int>(len);
+    }
+    catch (std::exception const & e)
+    {
+        ctx.error_ = e.what();
+    }
+    catch (...)
+    {
+        ctx.error_ = "Unknown error while providing the data to load.";
+    }
+
+    return -1;
+}
+
+void load_data_end(void * /* ptr */)
+{
+    // nothing to do, the context is owned by load_data()
+}
+
+int load_data_error(void *ptr, char *msg, unsigned int msgLen)
+{
+    load_data_context & ctx = *static_cast<load_data_context *>(ptr);
+
+    if (msgLen != 0)
+    {
+        std::size_t const len = (std::min)(
+            static_cast<std::size_t>(msgLen - 1), ctx.error_.size());
+        std::memcpy(msg, ctx.error_.data(), len);
+        msg[len] = '\0';
+    }
+
+    return CR_UNKNOWN_ERROR;
+}
+
+// Append the identifier to the query, quoted with backticks.
+void append_quoted_identifier(std::string & query,
+    std::string::const_iterator begin, std::string::const_iterator end)
+{
+    while (begin != end && std::isspace(static_cast<unsigned char>(*begin)))
+    {
+        ++begin;
+    }
+    while (begin != end && std::isspace(static_cast<unsigned char>(end[-1])))
+    {
+        --end;
+    }
+
+    if (begin == end)
+    {
+        throw soci_error("Empty table or column name in LOAD DATA.");
+    }
+
+    query += '`';
+    for (; begin != end; ++begin)
+    {
+        if (*begin == '`')
+        {
+            query += '`';
+        }
+        query += *begin;
+    }
+    query += '`';
+}
+
+// Append the list of identifiers separated by the given character to the
+// query, quoting each of them.
+void append_quoted_list(std::string & query, std::string const & list,
+    char separator, char const * joiner)
+{
+    std::string::const_iterator begin = list.begin();
+    for (;;)
+    {
+        std::string::const_iterator const end =
+            std::find(begin, list.end(), separator);
+        append_quoted_identifier(query, begin, end);
+        if (end == list.end())
+        {
+            break;
+        }
+
+        query += joiner;
+        begin = end + 1;
+    }
+}
+
+// Restores the default LOAD DATA LOCAL INFILE handler on scope exit.
+struct local_infile_handler_guard
+{
+    explicit local_infile_handler_guard(MYSQL *conn) : conn_(conn) {}
+    ~local_infile_handler_guard() { mysql_set_local_infile_default(conn_); }
+
+    MYSQL *conn_;
+
+    SOCI_NOT_COPYABLE(local_infile_handler_guard)
+};
+
+} // namespace anonymous
+
+long long mysql_session_backend::load_data(std::string const & table,
+    mysql_load_data_source & source, std::string const & columns,
+    std::size_t batchRows)
+{
+    if (batchRows == 0)
+    {
+        throw soci_error("The number of rows in a batch must be positive.");
+    }
+
+    // The file name is not used by our handler, but it must be present.
+    // The names are quoted as they can't be passed as parameters, the table
+    // name may be qualified by the database name.
+    std::string query("load data local infile 'soci' into table ");
+    append_quoted_list(query, table, '.', ".");
+    query += " character set ";
+    query += mysql_character_set_name(conn_);
+    if (!columns.empty())
+    {
+        query += " (";
+        append_quoted_list(query, columns, ',', ", ");
+        query += ")";
+    }
+
+    load_data_context ctx(source, batchRows);
+
+    local_infile_handler_guard guard(conn_);
+    mysql_set_local_infile_handler(conn_, load_data_init, load_data_read,
+        load_data_end, load_data_error, &ctx);
+
+    if (0 != mysql_real_query(conn_, query.c_str(),
+            static_cast<unsigned long>(query.size())))
+    {
+        if (!ctx.error_.empty())
+        {
+            throw soci_error(ctx.error_);
+        }
+
+        throw mysql_soci_error(mysql_error(conn_), mysql_errno(conn_));
+    }
+
+    return static_cast<long long>(mysql_affected_rows(conn_));
+}
@@ -173,7 +173,11 @@ void parse_connect_string(const string & connectString,
     string *charset, bool *charset_p,
     unsigned int *connect_timeout, bool *connect_timeout_p,
     unsigned int *read_timeout, bool *read_timeout_p,
-    unsigned int *write_timeout, bool *write_timeout_p)
+    unsigned int *write_timeout, bool *write_timeout_p,
+    unsigned int *statement_cache, bool *statement_cache_p,
+    int *use_result, bool *use_result_p,
+    int *nonblocking, bool *nonblocking_p,
+    int *batch_insert, bool *batch_insert_p)
 {
     *host_p = false;
     *user_p = false;
@@ -189,6 +193,10 @@ void parse_connect_string(const string & connectString,
     *connect_timeout_p = false;
     *read_timeout_p = false;
     *write_timeout_p = false;
+    *statement_cache_p = false;
+    *use_result_p = false;
+    *nonblocking_p = false;
+    *batch_insert_p = false;
     string err = "Malformed connection string.";
     string::const_iterator i = connectString.begin(),
         end = connectString.end();
@@ -301,6 +309,49 @@ void parse_connect_string(const string & connectString,
             char *end;
             *write_timeout = std::strtoul(val.c_str(), &end, 10);
             *write_timeout_p = true;
+        } else if (par == "statement_cache" && !*statement_cache_p)
+        {
+            if (!valid_uint(val))
+                throw soci_error(err);
+            char *end;
+            *statement_cache = std::strtoul(val.c_str(), &end, 10);
+            *statement_cache_p = true;
+        } else if (par == "use_result" && !*use_result_p)
+        {
+            if (!valid_int(val))
+            {
+                throw soci_error(err);
+            }
+            *use_result = std::atoi(val.c_str());
+            if (*use_result != 0 && *use_result != 1)
+            {
+                throw soci_error(err);
+            }
+            *use_result_p = true;
+        } else if (par == "nonblocking" && !*nonblocking_p)
+        {
+            if (!valid_int(val))
+            {
+                throw soci_error(err);
+            }
+            *nonblocking = std::atoi(val.c_str());
+            if (*nonblocking != 0 && *nonblocking != 1)
+            {
+                throw soci_error(err);
+            }
+            *nonblocking_p = true;
+        } else if (par == "batch_insert" && !*batch_insert_p)
+        {
+            if (!valid_int(val))
+            {
+                throw soci_error(err);
+            }
+            *batch_insert = std::atoi(val.c_str());
+            if (*batch_insert != 0 && *batch_insert != 1)
+            {
+                throw soci_error(err);
+            }
+            *batch_insert_p = true;
         }
         else
         {
@@ -325,14 +376,17 @@ void parse_connect_string(const string & connectString,
 
 mysql_session_backend::mysql_session_backend(
     connection_parameters const & parameters)
+    : stmtCacheSize_(0), useResult_(false), batchInsert_(false),
+      maxAllowedPacket_(0), nonblocking_(false)
 {
     string host, user, password, db, unix_socket, ssl_ca, ssl_cert, ssl_key,
         charset;
-    int port, local_infile;
-    unsigned int connect_timeout, read_timeout, write_timeout;
+    int port, local_infile, use_result, nonblocking, batch_insert;
+    unsigned int connect_timeout, read_timeout, write_timeout, statement_cache;
     bool host_p, user_p, password_p, db_p, unix_socket_p, port_p,
         ssl_ca_p, ssl_cert_p, ssl_key_p, local_infile_p, charset_p,
-        connect_timeout_p, read_timeout_p, write_timeout_p;
+        connect_timeout_p, read_timeout_p, write_timeout_p, statement_cache_p,
+        use_result_p, nonblocking_p, batch_insert_p;
     parse_connect_string(parameters.get_connect_string(), &host, &host_p, &user, &user_p,
         &password, &password_p, &db, &db_p,
         &unix_socket, &unix_socket_p, &port, &port_p,
@@ -340,7 +394,23 @@ mysql_session_backend::mysql_session_backend(
         &local_infile, &local_infile_p, &charset, &charset_p,
         &connect_timeout, &connect_timeout_p,
         &read_timeout, &read_timeout_p,
-        &write_timeout, &write_timeout_p);
+        &write_timeout, &write_timeout_p,
+        &statement_cache, &statement_cache_p,
+        &use_result, &use_result_p,
+        &nonblocking, &nonblocking_p,
+        &batch_insert, &batch_insert_p);
+    if (statement_cache_p)
+    {
+        stmtCacheSize_ = statement_cache;
+    }
+    if (use_result_p)
+    {
+        useResult_ = use_result == 1;
+    }
+    if (batch_insert_p)
+    {
+        batchInsert_ = batch_insert == 1;
+    }
     conn_ = mysql_init(NULL);
     if (conn_ == NULL)
     {
@@ -369,6 +439,21 @@ mysql_session_backend::mysql_session_backend(
                 "mysql_options() failed when trying to set local-infile.");
         }
     }
+    if (nonblocking_p && nonblocking == 1)
+    {
+#ifdef SOCI_MYSQL_NONBLOCKING
+        if (0 != mysql_options(conn_, MYSQL_OPT_NONBLOCK, 0))
+        {
+            clean_up();
+            throw soci_error("mysql_options(MYSQL_OPT_NONBLOCK) failed.");
+        }
+        nonblocking_ = true;
+#else
+        clean_up();
+        throw soci_error(
+            "Non-blocking mode requires MariaDB Connector/C.");
+#endif
+    }
     if (connect_timeout_p)
     {
         if (0 != mysql_options(conn_, MYSQL_OPT_CONNECT_TIMEOUT, &connect_timeout))
@@ -472,6 +557,13 @@ bool mysql_session_backend::get_last_insert_id(
 
 void mysql_session_backend::clean_up()
 {
+    for (statement_cache::iterator it = stmtCache_.begin();
+         it != stmtCache_.end(); ++it)
+    {
+        mysql_stmt_close(it->second);
+    }
+    stmtCache_.clear();
+
     if (conn_ != NULL)
     {
         mysql_close(conn_);
@@ -479,6 +571,76 @@ void mysql_session_backend::clean_up()
     }
 }
 
+MYSQL_STMT * mysql_session_backend::acquire_statement(
+    std::string const & query)
+{
+    for (statement_cache::iterator it = stmtCache_.begin();
+         it != stmtCache_.end(); ++it)
+    {
+        if (it->first == query)
+        {
+            MYSQL_STMT * const stmt = it->second;
+            stmtCache_.erase(it);
+            return stmt;
+        }
+    }
+
+    return NULL;
+}
+
+void mysql_session_backend::release_statement(
+    std::string const & query, MYSQL_STMT * stmt)
+{
+    // Reset the statement in case its execution failed or not all of its
+    // rows were fetched, closing it if even this doesn't work.
+    if (0 != mysql_stmt_reset(stmt))
+    {
+        mysql_stmt_close(stmt);
+        return;
+    }
+
+    stmtCache_.push_front(std::make_pair(query, stmt));
+
+    if (stmtCache_.size() > stmtCacheSize_)
+    {
+        mysql_stmt_close(stmtCache_.back().second);
+        stmtCache_.pop_back();
+    }
+}
+
+std::size_t mysql_session_backend::get_max_allowed_packet()
+{
+    if (maxAllowedPacket_ == 0)
+    {
+        std::string const query("select @@max_allowed_packet");
+        if (0 != mysql_real_query(conn_, query.c_str(),
+                static_cast<unsigned long>(query.size())))
+        {
+            throw mysql_soci_error(mysql_error(conn_), mysql_errno(conn_));
+        }
+
+        MYSQL_RES *result = mysql_store_result(conn_);
+        if (result == NULL)
+        {
+            throw mysql_soci_error(mysql_error(conn_), mysql_errno(conn_));
+        }
+
+        MYSQL_ROW row = mysql_fetch_row(result);
+        if (row != NULL && row[0] != NULL)
+        {
+            maxAllowedPacket_ = std::strtoul(row[0], NULL, 10);
+        }
+        mysql_free_result(result);
+
+        if (maxAllowedPacket_ == 0)
+        {
+            throw soci_error("Failed to retrieve max_allowed_packet.");
+        }
+    }
+
+    return maxAllowedPacket_;
+}
+
 mysql_statement_backend * mysql_session_backend::make_statement_backend()
 {
     return new mysql_statement_backend(*this);
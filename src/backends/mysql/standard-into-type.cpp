@@ -34,6 +34,8 @@ void mysql_standard_into_type_backend::define_by_pos(
     data_ = data;
     type_ = type;
     position_ = position++;
+
+    statement_.intoTypes_[position_] = type_;
 }
 
 void mysql_standard_into_type_backend::pre_fetch()
@@ -54,10 +56,8 @@ void mysql_standard_into_type_backend::post_fetch(
     if (gotData)
     {
         int pos = position_ - 1;
-        //mysql_data_seek(statement_.result_, statement_.currentRow_);
-        mysql_row_seek(statement_.result_,
-            statement_.resultRowOffsets_[statement_.currentRow_]);
-        MYSQL_ROW row = mysql_fetch_row(statement_.result_);
+        unsigned long * lengths;
+        MYSQL_ROW row = statement_.get_row(statement_.currentRow_, lengths);
         if (row[pos] == NULL)
         {
             if (ind == NULL)
@@ -76,6 +76,12 @@ void mysql_standard_into_type_backend::post_fetch(
             }
         }
         const char *buf = row[pos] != NULL ? row[pos] : "";
+        if (statement_.stmt_ != NULL
+            && statement_.get_native_value(pos, buf, type_, data_))
+        {
+            return;
+        }
+
         switch (type_)
         {
         case x_char:
@@ -84,11 +90,16 @@ void mysql_standard_into_type_backend::post_fetch(
         case x_stdstring:
             {
                 std::string& dest = exchange_type_cast<x_stdstring>(data_);
-                unsigned long * lengths =
-                    mysql_fetch_lengths(statement_.result_);
                 dest.assign(buf, lengths[pos]);
             }
             break;
+        case x_stringref:
+            {
+                string_ref& r = exchange_type_cast<x_stringref>(data_);
+                r.data = buf;
+                r.size = lengths[pos];
+            }
+            break;
         case x_short:
             parse_num(buf, exchange_type_cast<x_short>(data_));
             break;
@@ -108,6 +119,9 @@ void mysql_standard_into_type_backend::post_fetch(
             // attempt to parse the string and convert to std::tm
             parse_std_tm(buf, exchange_type_cast<x_stdtm>(data_));
             break;
+        case x_timestamp:
+            exchange_type_cast<x_timestamp>(data_).value = parse_timestamp(buf);
+            break;
         default:
             throw soci_error("Into element used with non-supported type.");
         }
@@ -12,6 +12,7 @@
 #include "soci/soci-platform.h"
 #include "soci-dtocstr.h"
 #include "soci-exchange-cast.h"
+#include "soci-mktime.h"
 // std
 #include <ciso646>
 #include <cstdio>
@@ -41,6 +42,14 @@ void mysql_standard_use_type_backend::bind_by_name(
 
 void mysql_standard_use_type_backend::pre_use(indicator const *ind)
 {
+    if (statement_.stmt_ != NULL)
+    {
+        // the value is bound directly, without formatting it as text
+        statement_.bind_prepared_param(position_, name_, data_, type_,
+            ind, false);
+        return;
+    }
+
     if (ind != NULL && *ind == i_null)
     {
         buf_ = new char[5];
@@ -119,11 +128,25 @@ void mysql_standard_use_type_backend::pre_use(indicator const *ind)
                 std::size_t const bufSize = 80;
                 buf_ = new char[bufSize];
 
-                std::tm const& t = exchange_type_cast<x_stdtm>(data_);
-                snprintf(buf_, bufSize,
-                    "\'%d-%02d-%02d %02d:%02d:%02d\'",
-                    t.tm_year + 1900, t.tm_mon + 1, t.tm_mday,
-                    t.tm_hour, t.tm_min, t.tm_sec);
+                // the value must be quoted in the query
+                buf_[0] = '\'';
+                int const len = format_std_tm(buf_ + 1, bufSize - 2,
+                    exchange_type_cast<x_stdtm>(data_));
+                buf_[len + 1] = '\'';
+                buf_[len + 2] = '\0';
+            }
+            break;
+        case x_timestamp:
+            {
+                std::size_t const bufSize = 80;
+                buf_ = new char[bufSize];
+
+                // the value must be quoted in the query
+                buf_[0] = '\'';
+                int const len = format_timestamp(buf_ + 1, bufSize - 2,
+                    exchange_type_cast<x_timestamp>(data_).value);
+                buf_[len + 1] = '\'';
+                buf_[len + 2] = '\0';
             }
             break;
         default:
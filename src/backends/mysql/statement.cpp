@@ -8,17 +8,332 @@
 
 #define SOCI_MYSQL_SOURCE
 #include "soci/mysql/soci-mysql.h"
+#include "soci/timestamp.h"
+#include "common.h"
+#include "soci-mktime.h"
+#include <mysqld_error.h>
 #include <cctype>
 #include <ciso646>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <limits>
 
 using namespace soci;
 using namespace soci::details;
+using namespace soci::details::mysql;
 using std::string;
 
+namespace // anonymous
+{
+
+// Check if the statement is a query or modifies the data, the statements
+// which are worth preparing on the server.
+bool is_preparable_query(std::string const & query)
+{
+    std::string::size_type const start = query.find_first_not_of(" \t\r\n(");
+    if (start == std::string::npos)
+    {
+        return false;
+    }
+
+    std::string keyword;
+    for (std::string::size_type i = start;
+         i != query.size() && std::isalpha(query[i]); ++i)
+    {
+        keyword += static_cast<char>(std::tolower(query[i]));
+    }
+
+    return keyword == "select" ||
+           keyword == "insert" || keyword == "update" ||
+           keyword == "delete" || keyword == "replace";
+}
+
+// Return the position of the opening parenthesis of the VALUES clause if the
+// query is a simple "INSERT ... VALUES (...)" with a single row of values and
+// nothing after it, so that more rows could be appended to it, or npos.
+std::string::size_type find_insert_values(std::string const & query)
+{
+    std::string::size_type const start = query.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos)
+    {
+        return std::string::npos;
+    }
+
+    std::string lower(query, start);
+    for (std::string::iterator it = lower.begin(); it != lower.end(); ++it)
+    {
+        *it = static_cast<char>(std::tolower(*it));
+    }
+
+    if (lower.compare(0, 6, "insert") != 0 &&
+        lower.compare(0, 7, "replace") != 0)
+    {
+        return std::string::npos;
+    }
+
+    // Find the first "values" keyword outside of the quotes.
+    std::string::size_type pos = std::string::npos;
+    char quote = '\0';
+    for (std::string::size_type i = 0; i != lower.size(); ++i)
+    {
+        char const c = lower[i];
+        if (quote != '\0')
+        {
+            if (c == '\\' && quote != '`' && i + 1 != lower.size())
+            {
+                ++i;
+            }
+            else if (c == quote)
+            {
+                quote = '\0';
+            }
+        }
+        else if (c == '\'' || c == '"' || c == '`')
+        {
+            quote = c;
+        }
+        else if (lower.compare(i, 6, "values") == 0 &&
+                 (i == 0 || !(std::isalnum(lower[i - 1]) || lower[i - 1] == '_')))
+        {
+            pos = lower.find_first_not_of(" \t\r\n", i + 6);
+            break;
+        }
+    }
+
+    if (pos == std::string::npos || lower[pos] != '(')
+    {
+        return std::string::npos;
+    }
+
+    // Check that the row of values is the last thing in the query.
+    int depth = 0;
+    std::string::size_type i = pos;
+    for (; i != lower.size(); ++i)
+    {
+        char const c = lower[i];
+        if (quote != '\0')
+        {
+            if (c == '\\' && quote != '`' && i + 1 != lower.size())
+            {
+                ++i;
+            }
+            else if (c == quote)
+            {
+                quote = '\0';
+            }
+        }
+        else if (c == '\'' || c == '"' || c == '`')
+        {
+            quote = c;
+        }
+        else if (c == '(')
+        {
+            ++depth;
+        }
+        else if (c == ')' && --depth == 0)
+        {
+            break;
+        }
+    }
+
+    if (i == lower.size() ||
+        lower.find_first_not_of(" \t\r\n", i + 1) != std::string::npos)
+    {
+        return std::string::npos;
+    }
+
+    return start + pos;
+}
+
+// Return the value of the scalar or the given element of the vector.
+template <typename T>
+T & param_value(mysql_statement_backend::prepared_param const & p, int row)
+{
+    return p.isVector_ ? (*static_cast<std::vector<T> *>(p.data_))[row]
+                       : *static_cast<T *>(p.data_);
+}
+
+void tm_to_mysql_time(std::tm const & t, int microseconds, MYSQL_TIME & mt)
+{
+    std::memset(&mt, 0, sizeof(mt));
+    mt.year = t.tm_year + 1900;
+    mt.month = t.tm_mon + 1;
+    mt.day = t.tm_mday;
+    mt.hour = t.tm_hour;
+    mt.minute = t.tm_min;
+    mt.second = t.tm_sec;
+    mt.second_part = microseconds;
+    mt.time_type = MYSQL_TIMESTAMP_DATETIME;
+}
+
+// Bind the value of the use element in the given row without converting it
+// to text, using the provided storage for the length and the date.
+void bind_param(MYSQL_BIND & b,
+    mysql_statement_backend::prepared_param const & p, int row,
+    unsigned long & length, MYSQL_TIME & mt)
+{
+    std::memset(&b, 0, sizeof(b));
+
+    if (p.ind_ != NULL && p.ind_[p.isVector_ ? row : 0] == i_null)
+    {
+        b.buffer_type = MYSQL_TYPE_NULL;
+        return;
+    }
+
+    switch (p.type_)
+    {
+    case x_char:
+        b.buffer_type = MYSQL_TYPE_STRING;
+        b.buffer = &param_value<char>(p, row);
+        length = 1;
+        b.length = &length;
+        break;
+    case x_stdstring:
+        {
+            std::string & str = param_value<std::string>(p, row);
+            b.buffer_type = MYSQL_TYPE_STRING;
+            b.buffer = const_cast<char *>(str.data());
+            length = static_cast<unsigned long>(str.size());
+            b.buffer_length = length;
+            b.length = &length;
+        }
+        break;
+    case x_short:
+        b.buffer_type = MYSQL_TYPE_SHORT;
+        b.buffer = &param_value<short>(p, row);
+        break;
+    case x_integer:
+        b.buffer_type = MYSQL_TYPE_LONG;
+        b.buffer = &param_value<int>(p, row);
+        break;
+    case x_long_long:
+        b.buffer_type = MYSQL_TYPE_LONGLONG;
+        b.buffer = &param_value<long long>(p, row);
+        break;
+    case x_unsigned_long_long:
+        b.buffer_type = MYSQL_TYPE_LONGLONG;
+        b.buffer = &param_value<unsigned long long>(p, row);
+        b.is_unsigned = 1;
+        break;
+    case x_double:
+        {
+            double & d = param_value<double>(p, row);
+            if (is_infinity_or_nan(d)) {
+                throw soci_error(
+                    "Use element used with infinity or NaN, which are "
+                    "not supported by the MySQL server.");
+            }
+            b.buffer_type = MYSQL_TYPE_DOUBLE;
+            b.buffer = &d;
+        }
+        break;
+    case x_stdtm:
+        tm_to_mysql_time(param_value<std::tm>(p, row), 0, mt);
+        b.buffer_type = MYSQL_TYPE_DATETIME;
+        b.buffer = &mt;
+        break;
+    case x_timestamp:
+        {
+            int microseconds = 0;
+            std::tm const t = timestamp_to_tm(
+                param_value<timestamp>(p, row), &microseconds);
+            tm_to_mysql_time(t, microseconds, mt);
+            b.buffer_type = MYSQL_TYPE_DATETIME;
+            b.buffer = &mt;
+        }
+        break;
+    default:
+        throw soci_error("Use element used with non-supported type.");
+    }
+}
+
+// MYSQL_BIND::is_null points to bool with MySQL 8 and to my_bool with the
+// other libraries, let the compiler deduce the type of the flags.
+template <typename Flag>
+void set_null_flag_storage(Flag *& isNull, char * storage)
+{
+    isNull = reinterpret_cast<Flag *>(storage);
+}
+
+template <typename Flag>
+bool is_null_flag_set(Flag const * isNull)
+{
+    return *isNull != 0;
+}
+
+// Errors caused by the values of a single row, which don't affect the other
+// rows of a multi-row INSERT or the transaction.
+bool is_row_data_error(unsigned int errNum)
+{
+    switch (errNum)
+    {
+    case ER_DUP_ENTRY:
+    case ER_BAD_NULL_ERROR:
+    case ER_NO_REFERENCED_ROW_2:
+    case ER_DATA_TOO_LONG:
+    case ER_WARN_DATA_OUT_OF_RANGE:
+    case ER_TRUNCATED_WRONG_VALUE_FOR_FIELD:
+        return true;
+    }
+
+    return false;
+}
+
+// Store the integer column value in the into element of type T, checking
+// that it fits into it.
+template <typename T>
+void store_integer(long long value, bool isUnsigned, void * data)
+{
+    typedef std::numeric_limits<T> limits;
+
+    bool fits;
+    if (isUnsigned)
+    {
+        fits = static_cast<unsigned long long>(value)
+                <= static_cast<unsigned long long>((limits::max)());
+    }
+    else if (limits::is_signed)
+    {
+        fits = value >= static_cast<long long>((limits::min)())
+            && value <= static_cast<long long>((limits::max)());
+    }
+    else
+    {
+        fits = value >= 0;
+    }
+
+    if (!fits)
+    {
+        throw soci_error("Cannot convert data.");
+    }
+
+    *static_cast<T *>(data) = static_cast<T>(value);
+}
+
+// Same as above for the floating point values, which must be integral.
+template <typename T>
+void store_integral_double(double value, void * data)
+{
+    typedef std::numeric_limits<T> limits;
+
+    if (!(value >= static_cast<double>((limits::min)())
+          && value < static_cast<double>((limits::max)()) + 1.0)
+        || value != std::floor(value))
+    {
+        throw soci_error("Cannot convert data.");
+    }
+
+    *static_cast<T *>(data) = static_cast<T>(value);
+}
+
+} // namespace anonymous
+
 
 mysql_statement_backend::mysql_statement_backend(
     mysql_session_backend &session)
-    : session_(session), result_(NULL),
+    : session_(session), result_(NULL), stmt_(NULL),
+       insertValuesPos_(std::string::npos),
        rowsAffectedBulk_(-1LL), justDescribed_(false),
        hasIntoElements_(false), hasVectorIntoElements_(false),
        hasUseElements_(false), hasVectorUseElements_(false)
@@ -31,6 +346,17 @@ void mysql_statement_backend::alloc()
 }
 
 void mysql_statement_backend::clean_up()
+{
+    free_result();
+
+    if (stmt_ != NULL)
+    {
+        session_.release_statement(preparedQuery_, stmt_);
+        stmt_ = NULL;
+    }
+}
+
+void mysql_statement_backend::free_result()
 {
     // 'reset' the value for a
     // potential new execution.
@@ -40,13 +366,25 @@ void mysql_statement_backend::clean_up()
     {
         mysql_free_result(result_);
         result_ = NULL;
+
+        if (stmt_ != NULL)
+        {
+            // discard the rows of the prepared statement not fetched yet
+            mysql_stmt_free_result(stmt_);
+        }
     }
 }
 
 void mysql_statement_backend::prepare(std::string const & query,
     statement_type /* eType */)
 {
+    clean_up();
+
     queryChunks_.clear();
+    names_.clear();
+    preparedParamsByPos_.clear();
+    preparedParamsByName_.clear();
+    intoTypes_.clear();
     enum { eNormal, eInQuotes, eInName } state = eNormal;
 
     std::string name;
@@ -117,6 +455,20 @@ void mysql_statement_backend::prepare(std::string const & query,
     {
         names_.push_back(name);
     }
+
+    // Rows of a bulk insert can only be sent together if no parameters
+    // appear before its VALUES clause.
+    insertValuesPos_ = find_insert_values(query);
+    if (insertValuesPos_ != std::string::npos &&
+        insertValuesPos_ >= queryChunks_.front().size())
+    {
+        insertValuesPos_ = std::string::npos;
+    }
+
+    if (session_.stmtCacheSize_ != 0 && is_preparable_query(query))
+    {
+        prepare_on_server();
+    }
 /*
   cerr << "Chunks: ";
   for (std::vector<std::string>::iterator i = queryChunks_.begin();
@@ -134,18 +486,366 @@ void mysql_statement_backend::prepare(std::string const & query,
 */
 }
 
+void mysql_statement_backend::prepare_on_server()
+{
+    preparedQuery_ = queryChunks_.front();
+    for (std::size_t n = 1; n < queryChunks_.size(); ++n)
+    {
+        preparedQuery_ += '?';
+        preparedQuery_ += queryChunks_[n];
+    }
+
+    stmt_ = session_.acquire_statement(preparedQuery_);
+    if (stmt_ != NULL)
+    {
+        return;
+    }
+
+    stmt_ = mysql_stmt_init(session_.conn_);
+    if (stmt_ == NULL)
+    {
+        throw soci_error("mysql_stmt_init() failed.");
+    }
+
+    // If the statement can't be prepared (e.g. it's not supported by the
+    // prepared statements protocol or contains "?" which is not a
+    // placeholder), just use the text protocol, which will also report any
+    // errors in it when it's executed.
+    if (0 != mysql_stmt_prepare(stmt_, preparedQuery_.c_str(),
+            static_cast<unsigned long>(preparedQuery_.size()))
+        || mysql_stmt_param_count(stmt_) != names_.size())
+    {
+        mysql_stmt_close(stmt_);
+        stmt_ = NULL;
+    }
+}
+
+void mysql_statement_backend::bind_prepared_param(int position,
+    std::string const &name, void *data, exchange_type type,
+    indicator const *ind, bool isVector)
+{
+    prepared_param p;
+    p.data_ = data;
+    p.type_ = type;
+    p.ind_ = ind;
+    p.isVector_ = isVector;
+
+    if (position > 0)
+    {
+        preparedParamsByPos_[position] = p;
+    }
+    else
+    {
+        preparedParamsByName_[name] = p;
+    }
+}
+
+statement_backend::exec_fetch_result
+mysql_statement_backend::execute_prepared(int number)
+{
+    if (not preparedParamsByPos_.empty() and not preparedParamsByName_.empty())
+    {
+        throw soci_error(
+            "Binding for use elements must be either by position "
+            "or by name.");
+    }
+
+    std::size_t const numParams = names_.size();
+    std::vector<prepared_param const *> params(numParams);
+    for (std::size_t n = 0; n != numParams; ++n)
+    {
+        if (not preparedParamsByPos_.empty())
+        {
+            PreparedParamsByPosMap::const_iterator const p
+                = preparedParamsByPos_.find(static_cast<int>(n + 1));
+            if (p == preparedParamsByPos_.end())
+            {
+                throw soci_error("Wrong number of parameters.");
+            }
+            params[n] = &p->second;
+        }
+        else
+        {
+            PreparedParamsByNameMap::const_iterator const p
+                = preparedParamsByName_.find(names_[n]);
+            if (p == preparedParamsByName_.end())
+            {
+                std::string msg("Missing use element for bind by name (");
+                msg += names_[n];
+                msg += ").";
+                throw soci_error(msg);
+            }
+            params[n] = &p->second;
+        }
+    }
+
+    paramBinds_.resize(numParams);
+    paramLengths_.resize(numParams);
+    paramTimes_.resize(numParams);
+
+    int const numberOfExecutions = hasVectorUseElements_ && number > 0
+                                 ? number : 1;
+
+    bool const hasResult = mysql_stmt_field_count(stmt_) != 0;
+    if (hasResult && numberOfExecutions > 1)
+    {
+        throw soci_error("The query shouldn't have returned"
+            " any data but it did.");
+    }
+
+    long long rowsAffectedBulkTemp = 0;
+    for (int i = 0; i != numberOfExecutions; ++i)
+    {
+        for (std::size_t n = 0; n != numParams; ++n)
+        {
+            bind_param(paramBinds_[n], *params[n], i,
+                paramLengths_[n], paramTimes_[n]);
+        }
+
+        if ((numParams != 0 && mysql_stmt_bind_param(stmt_, &paramBinds_[0]))
+            || 0 != mysql_stmt_execute(stmt_))
+        {
+            // preserve the number of rows affected so far.
+            rowsAffectedBulk_ = rowsAffectedBulkTemp;
+            throw mysql_soci_error(mysql_stmt_error(stmt_),
+                mysql_stmt_errno(stmt_));
+        }
+
+        rowsAffectedBulkTemp
+            += static_cast<long long>(mysql_stmt_affected_rows(stmt_));
+    }
+
+    if (hasResult == false)
+    {
+        rowsAffectedBulk_ = rowsAffectedBulkTemp;
+        return ef_no_data;
+    }
+
+    // The rows are fetched one by one into the result buffers and copied
+    // from them, as in the streaming mode, whether they are stored on the
+    // client first or not.
+    result_ = mysql_stmt_result_metadata(stmt_);
+    if (result_ == NULL)
+    {
+        throw mysql_soci_error(mysql_stmt_error(stmt_),
+            mysql_stmt_errno(stmt_));
+    }
+
+    bind_prepared_result();
+
+    if (!session_.useResult_)
+    {
+        if (0 != mysql_stmt_store_result(stmt_))
+        {
+            throw mysql_soci_error(mysql_stmt_error(stmt_),
+                mysql_stmt_errno(stmt_));
+        }
+
+        // as mysql_affected_rows() after mysql_store_result()
+        rowsAffectedBulk_
+            = static_cast<long long>(mysql_stmt_num_rows(stmt_));
+    }
+
+    currentRow_ = 0;
+    rowsToConsume_ = 0;
+    numberOfRows_ = 0;
+
+    return number > 0 ? fetch(number) : ef_success;
+}
+
+void mysql_statement_backend::bind_prepared_result()
+{
+    unsigned int const numFields = mysql_num_fields(result_);
+    MYSQL_FIELD const * const fields = mysql_fetch_fields(result_);
+
+    resultBinds_.resize(numFields);
+    resultBuffers_.resize(numFields);
+    resultLengths_.resize(numFields);
+    resultNulls_.assign(numFields * sizeof(*resultBinds_[0].is_null), 0);
+
+    for (unsigned int i = 0; i != numFields; ++i)
+    {
+        MYSQL_BIND & b = resultBinds_[i];
+        std::memset(&b, 0, sizeof(b));
+        b.length = &resultLengths_[i];
+        set_null_flag_storage(b.is_null,
+            &resultNulls_[i * sizeof(*b.is_null)]);
+
+        std::vector<char> & buffer = resultBuffers_[i];
+
+        // The values fetched into strings are always retrieved as text, the
+        // other ones are retrieved in the binary form matching the types of
+        // the into elements to which they can be fetched (and which are used
+        // for them by the row description too), if the column has one.
+        bool intoString = false;
+        IntoTypesMap::const_iterator const it
+            = intoTypes_.find(static_cast<int>(i + 1));
+        if (it != intoTypes_.end())
+        {
+            intoString = it->second == x_char
+                      || it->second == x_stdstring
+                      || it->second == x_stringref;
+        }
+
+        std::size_t nativeSize = 0;
+        if (!intoString)
+        {
+            switch (fields[i].type)
+            {
+            case MYSQL_TYPE_TINY:
+            case MYSQL_TYPE_SHORT:
+            case MYSQL_TYPE_INT24:
+            case MYSQL_TYPE_LONG:
+                if (fields[i].type == MYSQL_TYPE_LONG
+                    && (fields[i].flags & UNSIGNED_FLAG))
+                {
+                    // doesn't fit into a signed int
+                    b.buffer_type = MYSQL_TYPE_LONGLONG;
+                    nativeSize = sizeof(long long);
+                }
+                else
+                {
+                    b.buffer_type = MYSQL_TYPE_LONG;
+                    nativeSize = sizeof(int);
+                }
+                break;
+            case MYSQL_TYPE_LONGLONG:
+                b.buffer_type = MYSQL_TYPE_LONGLONG;
+                b.is_unsigned = (fields[i].flags & UNSIGNED_FLAG) != 0;
+                nativeSize = sizeof(long long);
+                break;
+            case MYSQL_TYPE_FLOAT:
+            case MYSQL_TYPE_DOUBLE:
+                b.buffer_type = MYSQL_TYPE_DOUBLE;
+                nativeSize = sizeof(double);
+                break;
+            case MYSQL_TYPE_DATE:
+            case MYSQL_TYPE_NEWDATE:
+            case MYSQL_TYPE_DATETIME:
+            case MYSQL_TYPE_TIMESTAMP:
+                b.buffer_type = MYSQL_TYPE_DATETIME;
+                nativeSize = sizeof(MYSQL_TIME);
+                break;
+            default:
+                // strings, blobs, decimals and the other types which don't
+                // have a binary form matching any into element type
+                break;
+            }
+        }
+
+        if (nativeSize != 0)
+        {
+            buffer.resize(nativeSize);
+            b.buffer = &buffer[0];
+            b.buffer_length = static_cast<unsigned long>(nativeSize);
+            continue;
+        }
+
+        // The buffers of the long values only grow when a value which
+        // doesn't fit is fetched, but the numbers formatted by the client
+        // library must fit into them with full precision.
+        unsigned long size = fields[i].length;
+        if (size < 64)
+        {
+            size = 64;
+        }
+        else if (size > 4096)
+        {
+            size = 4096;
+        }
+        if (buffer.size() < size)
+        {
+            buffer.resize(size);
+        }
+
+        b.buffer_type = MYSQL_TYPE_STRING;
+        b.buffer = &buffer[0];
+        b.buffer_length = static_cast<unsigned long>(buffer.size());
+    }
+
+    if (0 != mysql_stmt_bind_result(stmt_, &resultBinds_[0]))
+    {
+        throw mysql_soci_error(mysql_stmt_error(stmt_),
+            mysql_stmt_errno(stmt_));
+    }
+}
+
+void mysql_statement_backend::execute_bulk_query(std::string const &query,
+    long long &rowsAffectedBulkTemp)
+{
+    if (0 != mysql_real_query(session_.conn_, query.c_str(),
+            static_cast<unsigned long>(query.size())))
+    {
+        // preserve the number of rows affected so far.
+        rowsAffectedBulk_ = rowsAffectedBulkTemp;
+        throw mysql_soci_error(mysql_error(session_.conn_),
+            mysql_errno(session_.conn_));
+    }
+    else
+    {
+        if(rowsAffectedBulkTemp == -1)
+        {
+            rowsAffectedBulkTemp = 0;
+        }
+        rowsAffectedBulkTemp += static_cast<long long>(mysql_affected_rows(session_.conn_));
+    }
+    if (mysql_field_count(session_.conn_) != 0)
+    {
+        throw soci_error("The query shouldn't have returned"
+            " any data but it did.");
+    }
+}
+
+void mysql_statement_backend::execute_insert_batch(std::string const &batch,
+    std::vector<std::size_t> const &rowStarts,
+    long long &rowsAffectedBulkTemp)
+{
+    try
+    {
+        execute_bulk_query(batch, rowsAffectedBulkTemp);
+    }
+    catch (mysql_soci_error const & e)
+    {
+        // Other errors, e.g. a deadlock or a lost connection, may have
+        // aborted the transaction or would just happen again.
+        if (rowStarts.size() == 1 || !is_row_data_error(e.err_num_))
+        {
+            throw;
+        }
+
+        // A statement failing because of the data of one of its rows doesn't
+        // insert any rows into transactional tables, so insert the rows of
+        // the batch one by one to stop at the failing one with the rows
+        // preceding it inserted and counted, as without batching.
+        std::string query;
+        for (std::size_t n = 0; n != rowStarts.size(); ++n)
+        {
+            std::size_t const end = n + 1 != rowStarts.size()
+                                  ? rowStarts[n + 1] - 1 : batch.size();
+            query.assign(batch, 0, insertValuesPos_);
+            query.append(batch, rowStarts[n], end - rowStarts[n]);
+            execute_bulk_query(query, rowsAffectedBulkTemp);
+        }
+    }
+}
+
 statement_backend::exec_fetch_result
 mysql_statement_backend::execute(int number)
 {
     if (justDescribed_ == false)
     {
-        clean_up();
+        free_result();
 
         if (number > 1 && hasIntoElements_)
         {
              throw soci_error(
                   "Bulk use with single into elements is not supported.");
         }
+
+        if (stmt_ != NULL)
+        {
+            return execute_prepared(number);
+        }
         // number - size of vectors (into/use)
         // numberOfExecutions - number of loops to perform
         int numberOfExecutions = 1;
@@ -157,6 +857,16 @@ mysql_statement_backend::execute(int number)
         std::string query;
         if (not useByPosBuffers_.empty() or not useByNameBuffers_.empty())
         {
+            // In bulk mode, the rows of a simple INSERT are combined into
+            // multi-row statements not exceeding the maximal packet size.
+            bool const batchInsert = numberOfExecutions > 1
+                && insertValuesPos_ != std::string::npos
+                && session_.batchInsert_;
+            std::size_t const maxBatchSize = batchInsert
+                ? session_.get_max_allowed_packet() : 0;
+            std::string batch;
+            std::vector<std::size_t> batchRows; // start of each row values
+
             if (not useByPosBuffers_.empty() and not useByNameBuffers_.empty())
             {
                 throw soci_error(
@@ -214,46 +924,74 @@ mysql_statement_backend::execute(int number)
                     throw soci_error("Wrong number of parameters.");
                 }
 
+                // Compute the length of the query first to avoid reallocating
+                // (and so copying) it while appending possibly big values.
+                std::size_t const numParams = paramValues.size();
+                std::vector<std::size_t> paramLengths(numParams);
+                std::size_t queryLength = query.size();
+                for (std::size_t n = 0; n != numParams; ++n)
+                {
+                    paramLengths[n] = std::strlen(paramValues[n]);
+                    queryLength += queryChunks_[n].size() + paramLengths[n];
+                }
+                if (numParams < queryChunks_.size())
+                {
+                    queryLength += queryChunks_.back().size();
+                }
+                query.reserve(queryLength);
+
                 std::vector<std::string>::const_iterator ci
                     = queryChunks_.begin();
-                for (std::vector<char*>::const_iterator
-                         pi = paramValues.begin(), end = paramValues.end();
-                     pi != end; ++ci, ++pi)
+                for (std::size_t n = 0; n != numParams; ++ci, ++n)
                 {
                     query += *ci;
-                    query += *pi;
+                    query.append(paramValues[n], paramLengths[n]);
                 }
                 if (ci != queryChunks_.end())
                 {
                     query += *ci;
                 }
-                if (numberOfExecutions > 1)
+                if (batchInsert)
                 {
-                    // bulk operation
-                    //std::cerr << "bulk operation:\n" << query << std::endl;
-                    if (0 != mysql_real_query(session_.conn_, query.c_str(),
-                            static_cast<unsigned long>(query.size())))
+                    // The row values, including the parentheses, follow
+                    // the VALUES keyword, only the first row needs the
+                    // rest of the statement. Leave room for the command
+                    // byte in the packet.
+                    std::size_t const valuesSize
+                        = query.size() - insertValuesPos_;
+                    if (not batch.empty()
+                        and batch.size() + 1 + valuesSize >= maxBatchSize)
                     {
-                        // preserve the number of rows affected so far.
-                        rowsAffectedBulk_ = rowsAffectedBulkTemp;
-                        throw mysql_soci_error(mysql_error(session_.conn_),
-                            mysql_errno(session_.conn_));
+                        execute_insert_batch(batch, batchRows,
+                            rowsAffectedBulkTemp);
+                        batch.clear();
+                        batchRows.clear();
                     }
-                    else
+
+                    if (batch.empty())
                     {
-                        if(rowsAffectedBulkTemp == -1)
-                        {
-                            rowsAffectedBulkTemp = 0;
-                        }
-                        rowsAffectedBulkTemp += static_cast<long long>(mysql_affected_rows(session_.conn_));
+                        batch.swap(query);
+                        batchRows.push_back(insertValuesPos_);
                     }
-                    if (mysql_field_count(session_.conn_) != 0)
+                    else
                     {
-                        throw soci_error("The query shouldn't have returned"
-                            " any data but it did.");
+                        batch += ',';
+                        batchRows.push_back(batch.size());
+                        batch.append(query, insertValuesPos_, valuesSize);
                     }
                     query.clear();
                 }
+                else if (numberOfExecutions > 1)
+                {
+                    // bulk operation
+                    //std::cerr << "bulk operation:\n" << query << std::endl;
+                    execute_bulk_query(query, rowsAffectedBulkTemp);
+                    query.clear();
+                }
+            }
+            if (not batch.empty())
+            {
+                execute_insert_batch(batch, batchRows, rowsAffectedBulkTemp);
             }
             rowsAffectedBulk_ = rowsAffectedBulkTemp;
             if (numberOfExecutions > 1)
@@ -274,13 +1012,14 @@ mysql_statement_backend::execute(int number)
             throw mysql_soci_error(mysql_error(session_.conn_),
                 mysql_errno(session_.conn_));
         }
-        result_ = mysql_store_result(session_.conn_);
+        result_ = session_.useResult_ ? mysql_use_result(session_.conn_)
+                             : mysql_store_result(session_.conn_);
         if (result_ == NULL and mysql_field_count(session_.conn_) != 0)
         {
             throw mysql_soci_error(mysql_error(session_.conn_),
                 mysql_errno(session_.conn_));
         }
-        if (result_ != NULL)
+        if (result_ != NULL && !session_.useResult_)
         {
             // Cache the rows offsets to have random access to the rows later.
             // [mysql_data_seek() is O(n) so we don't want to use it].
@@ -298,7 +1037,16 @@ mysql_statement_backend::execute(int number)
         justDescribed_ = false;
     }
 
-    if (result_ != NULL)
+    if (result_ != NULL && (session_.useResult_ || stmt_ != NULL))
+    {
+        // the number of rows is unknown until they're all fetched
+        currentRow_ = 0;
+        rowsToConsume_ = 0;
+        numberOfRows_ = 0;
+
+        return number > 0 ? fetch(number) : ef_success;
+    }
+    else if (result_ != NULL)
     {
         currentRow_ = 0;
         rowsToConsume_ = 0;
@@ -338,6 +1086,11 @@ mysql_statement_backend::fetch(int number)
     // in the postFetch functions, called for each into element.
     // Here, we only prepare for this to happen (to emulate "the Oracle way").
 
+    if ((session_.useResult_ || stmt_ != NULL) && result_ != NULL)
+    {
+        return fetch_streamed(number);
+    }
+
     // forward the "cursor" from the last fetch
     currentRow_ += rowsToConsume_;
 
@@ -365,6 +1118,273 @@ mysql_statement_backend::fetch(int number)
     }
 }
 
+statement_backend::exec_fetch_result
+mysql_statement_backend::fetch_streamed(int number)
+{
+    // In the streaming mode the rows really are retrieved from the server
+    // here, but they still need to be copied as each mysql_fetch_row() call
+    // invalidates the previous row. The rows of the prepared statements are
+    // copied from their result buffers in the same way.
+    currentRow_ = 0;
+    rowsToConsume_ = 0;
+    numberOfRows_ = 0;
+
+    streamedData_.clear();
+    streamedOffsets_.clear();
+    streamedLengths_.clear();
+
+    unsigned int const numFields = mysql_num_fields(result_);
+    while (numberOfRows_ < number)
+    {
+        if (stmt_ != NULL)
+        {
+            if (!fetch_prepared_row())
+            {
+                break;
+            }
+
+            ++numberOfRows_;
+            continue;
+        }
+
+        MYSQL_ROW row = mysql_fetch_row(result_);
+        if (row == NULL)
+        {
+            if (mysql_errno(session_.conn_) != 0)
+            {
+                throw mysql_soci_error(mysql_error(session_.conn_),
+                    mysql_errno(session_.conn_));
+            }
+
+            break;
+        }
+
+        unsigned long * lengths = mysql_fetch_lengths(result_);
+        for (unsigned int i = 0; i != numFields; ++i)
+        {
+            if (row[i] == NULL)
+            {
+                streamedOffsets_.push_back(std::string::npos);
+                streamedLengths_.push_back(0);
+                continue;
+            }
+
+            streamedOffsets_.push_back(streamedData_.size());
+            streamedLengths_.push_back(lengths[i]);
+            streamedData_.insert(streamedData_.end(),
+                row[i], row[i] + lengths[i]);
+            streamedData_.push_back('\0');
+        }
+
+        ++numberOfRows_;
+    }
+
+    // Only take the addresses now as the buffer may have been reallocated.
+    streamedValues_.resize(streamedOffsets_.size());
+    for (std::size_t i = 0; i != streamedOffsets_.size(); ++i)
+    {
+        streamedValues_[i] = streamedOffsets_[i] == std::string::npos
+                           ? NULL : &streamedData_[streamedOffsets_[i]];
+    }
+
+    rowsToConsume_ = numberOfRows_;
+
+    // as in fetch(), ef_no_data means that the end of the rowset was hit,
+    // even if some rows were fetched
+    return numberOfRows_ < number ? ef_no_data : ef_success;
+}
+
+bool mysql_statement_backend::fetch_prepared_row()
+{
+    int const res = mysql_stmt_fetch(stmt_);
+    if (res == MYSQL_NO_DATA)
+    {
+        return false;
+    }
+    if (res != 0 && res != MYSQL_DATA_TRUNCATED)
+    {
+        throw mysql_soci_error(mysql_stmt_error(stmt_),
+            mysql_stmt_errno(stmt_));
+    }
+
+    bool rebind = false;
+    for (std::size_t i = 0; i != resultBinds_.size(); ++i)
+    {
+        MYSQL_BIND & b = resultBinds_[i];
+        if (is_null_flag_set(b.is_null))
+        {
+            streamedOffsets_.push_back(std::string::npos);
+            streamedLengths_.push_back(0);
+            continue;
+        }
+
+        std::vector<char> & buffer = resultBuffers_[i];
+        if (b.buffer_type != MYSQL_TYPE_STRING)
+        {
+            // copy the binary value, it is converted by get_native_value()
+            streamedOffsets_.push_back(streamedData_.size());
+            streamedLengths_.push_back(b.buffer_length);
+            streamedData_.insert(streamedData_.end(),
+                buffer.begin(), buffer.end());
+            continue;
+        }
+
+        unsigned long const length = resultLengths_[i];
+        if (length > buffer.size())
+        {
+            // Retrieve the truncated value again into a bigger buffer, which
+            // will also be used for the next rows.
+            buffer.resize(length);
+            b.buffer = &buffer[0];
+            b.buffer_length = length;
+            if (0 != mysql_stmt_fetch_column(stmt_, &b,
+                    static_cast<unsigned int>(i), 0))
+            {
+                throw mysql_soci_error(mysql_stmt_error(stmt_),
+                    mysql_stmt_errno(stmt_));
+            }
+            rebind = true;
+        }
+
+        streamedOffsets_.push_back(streamedData_.size());
+        streamedLengths_.push_back(length);
+        streamedData_.insert(streamedData_.end(),
+            buffer.begin(), buffer.begin() + length);
+        streamedData_.push_back('\0');
+    }
+
+    if (rebind && 0 != mysql_stmt_bind_result(stmt_, &resultBinds_[0]))
+    {
+        throw mysql_soci_error(mysql_stmt_error(stmt_),
+            mysql_stmt_errno(stmt_));
+    }
+
+    return true;
+}
+
+MYSQL_ROW mysql_statement_backend::get_row(int row, unsigned long *&lengths)
+{
+    if (session_.useResult_ || stmt_ != NULL)
+    {
+        std::size_t const first = row * mysql_num_fields(result_);
+        lengths = &streamedLengths_[first];
+        return &streamedValues_[first];
+    }
+
+    //mysql_data_seek(result_, row);
+    mysql_row_seek(result_, resultRowOffsets_[row]);
+    MYSQL_ROW const values = mysql_fetch_row(result_);
+    lengths = mysql_fetch_lengths(result_);
+    return values;
+}
+
+bool mysql_statement_backend::get_native_value(int pos, char const * buf,
+    exchange_type type, void * data)
+{
+    MYSQL_BIND const & b = resultBinds_[pos];
+    switch (b.buffer_type)
+    {
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+        {
+            long long value;
+            bool isUnsigned = false;
+            if (b.buffer_type == MYSQL_TYPE_LONG)
+            {
+                int n;
+                std::memcpy(&n, buf, sizeof(n));
+                value = n;
+            }
+            else
+            {
+                std::memcpy(&value, buf, sizeof(value));
+                isUnsigned = b.is_unsigned != 0;
+            }
+
+            switch (type)
+            {
+            case x_short:
+                store_integer<short>(value, isUnsigned, data);
+                break;
+            case x_integer:
+                store_integer<int>(value, isUnsigned, data);
+                break;
+            case x_long_long:
+                store_integer<long long>(value, isUnsigned, data);
+                break;
+            case x_unsigned_long_long:
+                store_integer<unsigned long long>(value, isUnsigned, data);
+                break;
+            case x_double:
+                *static_cast<double *>(data) = isUnsigned
+                    ? static_cast<double>(static_cast<unsigned long long>(value))
+                    : static_cast<double>(value);
+                break;
+            default:
+                throw soci_error("Cannot convert data.");
+            }
+        }
+        return true;
+
+    case MYSQL_TYPE_DOUBLE:
+        {
+            double value;
+            std::memcpy(&value, buf, sizeof(value));
+
+            switch (type)
+            {
+            case x_short:
+                store_integral_double<short>(value, data);
+                break;
+            case x_integer:
+                store_integral_double<int>(value, data);
+                break;
+            case x_long_long:
+                store_integral_double<long long>(value, data);
+                break;
+            case x_unsigned_long_long:
+                store_integral_double<unsigned long long>(value, data);
+                break;
+            case x_double:
+                *static_cast<double *>(data) = value;
+                break;
+            default:
+                throw soci_error("Cannot convert data.");
+            }
+        }
+        return true;
+
+    case MYSQL_TYPE_DATETIME:
+        {
+            MYSQL_TIME mt;
+            std::memcpy(&mt, buf, sizeof(mt));
+
+            // as parse_std_tm() does for the same value formatted as text
+            std::tm t = std::tm();
+            tm_from_ymdhms(t, mt.year, mt.month, mt.day,
+                mt.hour, mt.minute, mt.second);
+
+            switch (type)
+            {
+            case x_stdtm:
+                *static_cast<std::tm *>(data) = t;
+                break;
+            case x_timestamp:
+                *static_cast<timestamp *>(data) = timestamp_from_tm(t,
+                    static_cast<int>(mt.second_part));
+                break;
+            default:
+                throw soci_error("Cannot convert data.");
+            }
+        }
+        return true;
+
+    default:
+        // retrieved as text
+        return false;
+    }
+}
+
 long long mysql_statement_backend::get_affected_rows()
 {
     if (rowsAffectedBulk_ >= 0)
@@ -394,10 +1414,14 @@ std::string mysql_statement_backend::rewrite_for_procedure_call(
 
 int mysql_statement_backend::prepare_for_describe()
 {
-    execute(1);
+    // Don't consume any rows in the streaming mode or for the prepared
+    // statements, they couldn't be fetched again by the execute() following
+    // this call.
+    execute(session_.useResult_ || stmt_ != NULL ? 0 : 1);
     justDescribed_ = true;
 
-    int columns = mysql_field_count(session_.conn_);
+    int columns = stmt_ != NULL ? mysql_stmt_field_count(stmt_)
+                                : mysql_field_count(session_.conn_);
     return columns;
 }
 
@@ -11,6 +11,8 @@
 #include "soci-mktime.h"
 #include "common.h"
 #include "soci/soci-platform.h"
+#include "soci/timestamp.h"
+#include "soci/type-wrappers.h"
 #include <ciso646>
 #include <cstdlib>
 
@@ -24,6 +26,8 @@ void mysql_vector_into_type_backend::define_by_pos(
     data_ = data;
     type_ = type;
     position_ = position++;
+
+    statement_.intoTypes_[position_] = type_;
 }
 
 void mysql_vector_into_type_backend::pre_fetch()
@@ -44,6 +48,31 @@ void set_invector_(void *p, int indx, T const &val)
     v[indx] = val;
 }
 
+template <typename T>
+void *invector_element_(void *p, int indx)
+{
+    std::vector<T> &v = *static_cast<std::vector<T> *>(p);
+    return &v[indx];
+}
+
+// Return the address of the element of the vector, for the types which can
+// be retrieved in the binary form, or NULL.
+void *native_element_(void *p, exchange_type type, int indx)
+{
+    switch (type)
+    {
+    case x_short:   return invector_element_<short>(p, indx);
+    case x_integer: return invector_element_<int>(p, indx);
+    case x_long_long: return invector_element_<long long>(p, indx);
+    case x_unsigned_long_long:
+        return invector_element_<unsigned long long>(p, indx);
+    case x_double:  return invector_element_<double>(p, indx);
+    case x_stdtm:   return invector_element_<std::tm>(p, indx);
+    case x_timestamp: return invector_element_<timestamp>(p, indx);
+    default:        return NULL;
+    }
+}
+
 } // namespace anonymous
 
 void mysql_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
@@ -58,13 +87,14 @@ void mysql_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
 
         int const endRow = statement_.currentRow_ + statement_.rowsToConsume_;
 
-        //mysql_data_seek(statement_.result_, statement_.currentRow_);
-        mysql_row_seek(statement_.result_,
-            statement_.resultRowOffsets_[statement_.currentRow_]);
+        // used for parsing all std::tm values
+        std_tm_parser tmParser;
+
         for (int curRow = statement_.currentRow_, i = 0;
              curRow != endRow; ++curRow, ++i)
         {
-            MYSQL_ROW row = mysql_fetch_row(statement_.result_);
+            unsigned long * lengths;
+            MYSQL_ROW row = statement_.get_row(curRow, lengths);
             // first, deal with indicators
             if (row[pos] == NULL)
             {
@@ -87,9 +117,20 @@ void mysql_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
                 }
             }
 
-            // buffer with data retrieved from server, in text format
+            // buffer with data retrieved from server, in text format, or in
+            // the binary form for the prepared statements
             const char *buf = row[pos] != NULL ? row[pos] : "";
 
+            if (statement_.stmt_ != NULL)
+            {
+                void *const elem = native_element_(data_, type_, i);
+                if (elem != NULL
+                    && statement_.get_native_value(pos, buf, type_, elem))
+                {
+                    continue;
+                }
+            }
+
             switch (type_)
             {
             case x_char:
@@ -97,8 +138,6 @@ void mysql_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
                 break;
             case x_stdstring:
                 {
-                    unsigned long * lengths =
-                        mysql_fetch_lengths(statement_.result_);
                     // Not sure if it's necessary, but the code below is used
                     // instead of
                     // set_invector_(data_, i, std::string(buf, lengths[pos]);
@@ -108,6 +147,14 @@ void mysql_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
                     (*dest)[i].assign(buf, lengths[pos]);
                 }
                 break;
+            case x_stringref:
+                {
+                    string_ref r;
+                    r.data = buf;
+                    r.size = lengths[pos];
+                    set_invector_(data_, i, r);
+                }
+                break;
             case x_short:
                 {
                     short val;
@@ -147,11 +194,17 @@ void mysql_vector_into_type_backend::post_fetch(bool gotData, indicator *ind)
                 {
                     // attempt to parse the string and convert to std::tm
                     std::tm t = std::tm();
-                    parse_std_tm(buf, t);
+                    tmParser.parse(buf, t);
 
                     set_invector_(data_, i, t);
                 }
                 break;
+            case x_timestamp:
+                {
+                    timestamp const ts(parse_timestamp(buf));
+                    set_invector_(data_, i, ts);
+                }
+                break;
 
             default:
                 throw soci_error("Into element used with non-supported type.");
@@ -191,6 +244,8 @@ void mysql_vector_into_type_backend::resize(std::size_t sz)
     case x_double:       resizevector_<double>       (data_, sz); break;
     case x_stdstring:    resizevector_<std::string>  (data_, sz); break;
     case x_stdtm:        resizevector_<std::tm>      (data_, sz); break;
+    case x_stringref:    resizevector_<string_ref>   (data_, sz); break;
+    case x_timestamp:    resizevector_<timestamp>    (data_, sz); break;
 
     default:
         throw soci_error("Into vector element used with non-supported type.");
@@ -213,6 +268,8 @@ std::size_t mysql_vector_into_type_backend::size()
     case x_double:       sz = get_vector_size<double>       (data_); break;
     case x_stdstring:    sz = get_vector_size<std::string>  (data_); break;
     case x_stdtm:        sz = get_vector_size<std::tm>      (data_); break;
+    case x_stringref:    sz = get_vector_size<string_ref>   (data_); break;
+    case x_timestamp:    sz = get_vector_size<timestamp>    (data_); break;
 
     default:
         throw soci_error("Into vector element used with non-supported type.");
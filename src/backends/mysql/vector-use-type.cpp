@@ -10,7 +10,9 @@
 #include "soci/mysql/soci-mysql.h"
 #include "common.h"
 #include "soci/soci-platform.h"
+#include "soci/timestamp.h"
 #include "soci-dtocstr.h"
+#include "soci-mktime.h"
 // std
 #include <ciso646>
 #include <cstddef>
@@ -45,6 +47,14 @@ void mysql_vector_use_type_backend::bind_by_name(
 
 void mysql_vector_use_type_backend::pre_use(indicator const *ind)
 {
+    if (statement_.stmt_ != NULL)
+    {
+        // the values are bound directly, without formatting them as text
+        statement_.bind_prepared_param(position_, name_, data_, type_,
+            ind, true);
+        return;
+    }
+
     std::size_t const vsize = size();
     for (size_t i = 0; i != vsize; ++i)
     {
@@ -156,9 +166,28 @@ void mysql_vector_use_type_backend::pre_use(indicator const *ind)
                     std::size_t const bufSize = 80;
                     buf = new char[bufSize];
 
-                    snprintf(buf, bufSize, "\'%d-%02d-%02d %02d:%02d:%02d\'",
-                        v[i].tm_year + 1900, v[i].tm_mon + 1, v[i].tm_mday,
-                        v[i].tm_hour, v[i].tm_min, v[i].tm_sec);
+                    // the value must be quoted in the query
+                    buf[0] = '\'';
+                    int const len = format_std_tm(buf + 1, bufSize - 2, v[i]);
+                    buf[len + 1] = '\'';
+                    buf[len + 2] = '\0';
+                }
+                break;
+            case x_timestamp:
+                {
+                    std::vector<timestamp> *pv
+                        = static_cast<std::vector<timestamp> *>(data_);
+                    std::vector<timestamp> &v = *pv;
+
+                    std::size_t const bufSize = 80;
+                    buf = new char[bufSize];
+
+                    // the value must be quoted in the query
+                    buf[0] = '\'';
+                    int const len = format_timestamp(buf + 1, bufSize - 2,
+                        v[i].value);
+                    buf[len + 1] = '\'';
+                    buf[len + 2] = '\0';
                 }
                 break;
 
@@ -199,6 +228,7 @@ std::size_t mysql_vector_use_type_backend::size()
     case x_double:       sz = get_vector_size<double>       (data_); break;
     case x_stdstring:    sz = get_vector_size<std::string>  (data_); break;
     case x_stdtm:        sz = get_vector_size<std::tm>      (data_); break;
+    case x_timestamp:    sz = get_vector_size<timestamp>    (data_); break;
 
     default:
         throw soci_error("Use vector element used with non-supported type.");
@@ -214,4 +244,5 @@ void mysql_vector_use_type_backend::clean_up()
     {
         delete [] buffers_[i];
     }
+    buffers_.clear();
 }
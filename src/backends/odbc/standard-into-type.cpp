@@ -8,10 +8,11 @@
 #define SOCI_ODBC_SOURCE
 #include "soci/soci-platform.h"
 #include "soci/odbc/soci-odbc.h"
+#include "soci-cstrtod.h"
 #include "soci-exchange-cast.h"
 #include "soci-mktime.h"
+#include <cstring>
 #include <ctime>
-#include <stdio.h>  // sscanf()
 
 using namespace soci;
 using namespace soci::details;
@@ -33,6 +34,7 @@ void odbc_standard_into_type_backend::define_by_pos(
         data = buf_;
         break;
     case x_stdstring:
+    case x_stringref:
     case x_longstring:
     case x_xmltype:
         odbcType_ = SQL_C_CHAR;
@@ -161,6 +163,16 @@ void odbc_standard_into_type_backend::post_fetch(
                 throw soci_error("Buffer size overflow; maybe got too large string");
             }
         }
+        else if (type_ == x_stringref)
+        {
+            string_ref& r = exchange_type_cast<x_stringref>(data_);
+            r.data = buf_;
+            r.size = std::strlen(buf_);
+            if (r.size >= (odbc_max_buffer_length - 1))
+            {
+                throw soci_error("Buffer size overflow; maybe got too large string");
+            }
+        }
         else if (type_ == x_longstring)
         {
             exchange_type_cast<x_longstring>(data_).value = buf_;
@@ -182,7 +194,7 @@ void odbc_standard_into_type_backend::post_fetch(
         else if (type_ == x_long_long && use_string_for_bigint())
         {
           long long& ll = exchange_type_cast<x_long_long>(data_);
-          if (sscanf(buf_, "%" LL_FMT_FLAGS "d", &ll) != 1)
+          if (!cstring_to_integer(buf_, ll))
           {
             throw soci_error("Failed to parse the returned 64-bit integer value");
           }
@@ -190,7 +202,7 @@ void odbc_standard_into_type_backend::post_fetch(
         else if (type_ == x_unsigned_long_long && use_string_for_bigint())
         {
           unsigned long long& ll = exchange_type_cast<x_unsigned_long_long>(data_);
-          if (sscanf(buf_, "%" LL_FMT_FLAGS "u", &ll) != 1)
+          if (!cstring_to_integer(buf_, ll))
           {
             throw soci_error("Failed to parse the returned 64-bit integer value");
           }
@@ -375,6 +375,8 @@ void odbc_vector_use_type_backend::pre_use(indicator const *ind)
         case x_blob:
         case x_xmltype:
         case x_longstring:
+        case x_timestamp:
+        case x_stringref:
             // Those are unreachable, we would have thrown from
             // prepare_for_bind() if we we were using one of them, only handle
             // them here to avoid compiler warnings about unhandled enum
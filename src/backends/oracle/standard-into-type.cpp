@@ -160,6 +160,12 @@ void oracle_standard_into_type_backend::define_by_pos(
             ociData_ = lobp;
         }
         break;
+
+    case x_timestamp:
+        throw soci_error("Timestamp type is not supported by Oracle backend.");
+
+    case x_stringref:
+        throw soci_error("String references are not supported by Oracle backend.");
     }
 
     sword res = OCIDefineByPos(statement_.stmtp_, &defnp_,
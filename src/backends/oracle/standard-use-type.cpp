@@ -158,6 +158,12 @@ void oracle_standard_use_type_backend::prepare_for_bind(
             ociData_ = lobp;
         }
         break;
+
+    case x_timestamp:
+        throw soci_error("Timestamp type is not supported by Oracle backend.");
+
+    case x_stringref:
+        throw soci_error("String references are not supported by Oracle backend.");
     }
 }
 
@@ -393,6 +399,8 @@ void oracle_standard_use_type_backend::pre_use(indicator const *ind)
     case x_longstring:
     case x_rowid:
     case x_blob:
+    case x_timestamp:
+    case x_stringref:
         // nothing to do
         break;
     }
@@ -559,6 +567,8 @@ void oracle_standard_use_type_backend::post_use(bool gotData, indicator *ind)
         case x_blob:
         case x_xmltype:
         case x_longstring:
+        case x_timestamp:
+        case x_stringref:
             // nothing to do here
             break;
         }
@@ -163,6 +163,8 @@ void oracle_vector_into_type_backend::define_by_pos_bulk(
     case x_statement:
     case x_rowid:
     case x_blob:
+    case x_timestamp:
+    case x_stringref:
         throw soci_error("Unsupported type for vector into parameter");
     }
 
@@ -388,6 +390,8 @@ void oracle_vector_into_type_backend::resize(std::size_t sz)
         case x_statement:  break; // not supported
         case x_rowid:      break; // not supported
         case x_blob:       break; // not supported
+        case x_timestamp:  break; // not supported
+        case x_stringref:  break; // not supported
         }
 
         end_var_ = sz;
@@ -483,6 +487,8 @@ std::size_t oracle_vector_into_type_backend::full_size()
     case x_statement:  break; // not supported
     case x_rowid:      break; // not supported
     case x_blob:       break; // not supported
+    case x_timestamp:  break; // not supported
+    case x_stringref:  break; // not supported
     }
 
     return sz;
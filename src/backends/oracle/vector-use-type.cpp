@@ -160,6 +160,8 @@ void oracle_vector_use_type_backend::prepare_for_bind(
     case x_statement:  break; // not supported
     case x_rowid:      break; // not supported
     case x_blob:       break; // not supported
+    case x_timestamp:  break; // not supported
+    case x_stringref:  break; // not supported
     }
 }
 
@@ -405,6 +407,8 @@ std::size_t oracle_vector_use_type_backend::full_size()
     case x_statement:  break; // not supported
     case x_rowid:      break; // not supported
     case x_blob:       break; // not supported
+    case x_timestamp:  break; // not supported
+    case x_stringref:  break; // not supported
     }
 
     return sz;
@@ -9,6 +9,7 @@
 #define SOCI_POSTGRESQL_COMMON_H_INCLUDED
 
 #include "soci/postgresql/soci-postgresql.h"
+#include "soci-cstrtod.h"
 #include <limits>
 #include <cstdio>
 #include <cstring>
@@ -28,44 +29,26 @@ namespace postgresql
 template <typename T>
 T string_to_integer(char const * buf)
 {
-    long long t(0);
-    int n(0);
-    int const converted = std::sscanf(buf, "%" LL_FMT_FLAGS "d%n", &t, &n);
-    if (converted == 1 && static_cast<std::size_t>(n) == std::strlen(buf))
+    T t;
+    if (cstring_to_integer(buf, t))
     {
-        // successfully converted to long long
-        // and no other characters were found in the buffer
+        return t;
+    }
+
+    // try additional conversion from boolean
+    // (PostgreSQL gives 't' or 'f' for boolean results)
 
-        const T max = (std::numeric_limits<T>::max)();
-        const T min = (std::numeric_limits<T>::min)();
-        if (t <= static_cast<long long>(max) &&
-            t >= static_cast<long long>(min))
-        {
-            return static_cast<T>(t);
-        }
-        else
-        {
-            // value out of target range
-            throw soci_error("Cannot convert data.");
-        }
+    if (buf[0] == 't' && buf[1] == '\0')
+    {
+        return static_cast<T>(1);
+    }
+    else if (buf[0] == 'f' && buf[1] == '\0')
+    {
+        return static_cast<T>(0);
     }
     else
     {
-        // try additional conversion from boolean
-        // (PostgreSQL gives 't' or 'f' for boolean results)
-
-        if (buf[0] == 't' && buf[1] == '\0')
-        {
-            return static_cast<T>(1);
-        }
-        else if (buf[0] == 'f' && buf[1] == '\0')
-        {
-            return static_cast<T>(0);
-        }
-        else
-        {
-            throw soci_error("Cannot convert data.");
-        }
+        throw soci_error("Cannot convert data.");
     }
 }
 
@@ -73,43 +56,8 @@ T string_to_integer(char const * buf)
 template <typename T>
 T string_to_unsigned_integer(char const * buf)
 {
-    unsigned long long t(0);
-    int n(0);
-    int const converted = std::sscanf(buf, "%" LL_FMT_FLAGS "u%n", &t, &n);
-    if (converted == 1 && static_cast<std::size_t>(n) == std::strlen(buf))
-    {
-        // successfully converted to unsigned long long
-        // and no other characters were found in the buffer
-
-        const T max = (std::numeric_limits<T>::max)();
-        if (t <= static_cast<unsigned long long>(max))
-        {
-            return static_cast<T>(t);
-        }
-        else
-        {
-            // value out of target range
-            throw soci_error("Cannot convert data.");
-        }
-    }
-    else
-    {
-        // try additional conversion from boolean
-        // (PostgreSQL gives 't' or 'f' for boolean results)
-
-        if (buf[0] == 't' && buf[1] == '\0')
-        {
-            return static_cast<T>(1);
-        }
-        else if (buf[0] == 'f' && buf[1] == '\0')
-        {
-            return static_cast<T>(0);
-        }
-        else
-        {
-            throw soci_error("Cannot convert data.");
-        }
-    }
+    // cstring_to_integer() handles both signed and unsigned types
+    return string_to_integer<T>(buf);
 }
 
 // helper for vector operations
@@ -74,6 +74,12 @@ details::postgresql_result::check_for_data(char const* errMsg) const
             return false;
 
         case PGRES_TUPLES_OK:
+#ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
+        case PGRES_SINGLE_TUPLE:
+#endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
+#ifdef LIBPQ_HAS_CHUNK_MODE
+        case PGRES_TUPLES_CHUNK:
+#endif // LIBPQ_HAS_CHUNK_MODE
             return true;
 
         case PGRES_FATAL_ERROR:
@@ -10,6 +10,7 @@
 #include "soci/connection-parameters.h"
 #include "soci/backend-loader.h"
 #include <libpq/libpq-fs.h> // libpq
+#include <sstream>
 
 #ifdef _MSC_VER
 #pragma warning(disable:4355)
@@ -71,11 +72,13 @@ std::string::const_iterator get_key_value(std::string::const_iterator & i,
 // retrieves specific parameters from the
 // uniform connect string
 std::string chop_connect_string(std::string const & connectString,
-    bool & single_row_mode)
+    bool & single_row_mode, bool & cursor_mode,
+    std::size_t & deallocate_batch_size)
 {
     std::string pruned_conn_string;
 
     single_row_mode = false;
+    cursor_mode = false;
 
     std::string key, value;
     std::string::const_iterator i = connectString.begin();
@@ -86,6 +89,19 @@ std::string chop_connect_string(std::string const & connectString,
         {
             single_row_mode = (value == "true" || value == "yes");
         }
+        else if (key == "cursor" || key == "cursors")
+        {
+            cursor_mode = (value == "true" || value == "yes");
+        }
+        else if (key == "deallocate_batch")
+        {
+            std::istringstream iss(value);
+            if (!(iss >> deallocate_batch_size) || !iss.eof())
+            {
+                throw soci_error("Invalid value of deallocate_batch parameter: \"" +
+                    value + "\".");
+            }
+        }
         else
         {
             if (pruned_conn_string.empty() == false)
@@ -107,14 +123,18 @@ postgresql_session_backend * postgresql_backend_factory::make_session(
      connection_parameters const & parameters) const
 {
     bool single_row_mode;
+    bool cursor_mode;
+    std::size_t deallocate_batch_size = 16;
 
     const std::string pruned_conn_string =
-        chop_connect_string(parameters.get_connect_string(), single_row_mode);
+        chop_connect_string(parameters.get_connect_string(),
+            single_row_mode, cursor_mode, deallocate_batch_size);
 
     connection_parameters pruned_parameters(parameters);
     pruned_parameters.set_connect_string(pruned_conn_string);
 
-    return new postgresql_session_backend(pruned_parameters, single_row_mode);
+    return new postgresql_session_backend(pruned_parameters,
+        single_row_mode, cursor_mode, deallocate_batch_size);
 }
 
 postgresql_backend_factory const soci::postgresql;
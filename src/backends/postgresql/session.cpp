@@ -33,10 +33,18 @@ void hard_exec(postgresql_session_backend & session_backend,
 } // namespace unnamed
 
 postgresql_session_backend::postgresql_session_backend(
-    connection_parameters const& parameters, bool single_row_mode)
-    : statementCount_(0)
+    connection_parameters const& parameters, bool single_row_mode,
+    bool cursor_mode, std::size_t deallocate_batch_size)
+    : statementCount_(0), cursorCount_(0), transactionCount_(0),
+      deallocate_batch_size_(deallocate_batch_size)
 {
+    if (single_row_mode && cursor_mode)
+    {
+        throw soci_error("Single-row and cursor modes can't be used together.");
+    }
+
     single_row_mode_ = single_row_mode;
+    cursor_mode_ = cursor_mode;
 
     connect(parameters);
 }
@@ -78,26 +86,125 @@ postgresql_session_backend::~postgresql_session_backend()
 
 void postgresql_session_backend::begin()
 {
+    ++transactionCount_;
     hard_exec(*this, conn_, "BEGIN", "Cannot begin transaction.");
 }
 
 void postgresql_session_backend::commit()
 {
-    hard_exec(*this, conn_, "COMMIT", "Cannot commit transaction.");
+    end_transaction("COMMIT", "Cannot commit transaction.");
 }
 
 void postgresql_session_backend::rollback()
 {
-    hard_exec(*this, conn_, "ROLLBACK", "Cannot rollback transaction.");
+    end_transaction("ROLLBACK", "Cannot rollback transaction.");
+}
+
+void postgresql_session_backend::end_transaction(
+    char const * command, char const * errMsg)
+{
+    ++transactionCount_;
+
+    if (pendingDeallocations_.empty())
+    {
+        hard_exec(*this, conn_, command, errMsg);
+        return;
+    }
+
+    // The statements which couldn't be deallocated during the transaction
+    // are deallocated by the same query ending it, once it is over, so that
+    // this doesn't cost an extra round trip.
+    std::string query(command);
+    query += ";";
+    query += make_deallocate_query();
+
+    if (PQsendQuery(conn_, query.c_str()) != 1)
+    {
+        std::string description = errMsg;
+        description += " ";
+        description += PQerrorMessage(conn_);
+        throw soci_error(description);
+    }
+
+    // Only the result of the transaction command matters, failing to
+    // deallocate a statement just leaves it allocated until the end of the
+    // connection.
+    postgresql_result result(*this, PQgetResult(conn_));
+    while (PGresult * res = PQgetResult(conn_))
+    {
+        PQclear(res);
+    }
+
+    result.check_for_errors(errMsg);
 }
 
 void postgresql_session_backend::deallocate_prepared_statement(
     const std::string & statementName)
 {
-    const std::string & query = "DEALLOCATE " + statementName;
+    pendingDeallocations_.push_back(statementName);
 
-    hard_exec(*this, conn_, query.c_str(),
-        "Cannot deallocate prepared statement.");
+    if (deallocate_batch_size_ == 0)
+    {
+        deallocate_pending_statements(true);
+    }
+}
+
+void postgresql_session_backend::deallocate_pending_statements(bool force)
+{
+    if (pendingDeallocations_.empty() ||
+        (force == false &&
+            pendingDeallocations_.size() < deallocate_batch_size_))
+    {
+        return;
+    }
+
+    if (0 == conn_)
+    {
+        return;
+    }
+
+    // Unless we're asked to do it right now, only deallocate the statements
+    // outside of any transaction: this ensures that an error here can't
+    // abort the transaction of the application (or fail because it had been
+    // already aborted).
+    if (force == false && PQtransactionStatus(conn_) != PQTRANS_IDLE)
+    {
+        return;
+    }
+
+    std::string const query = make_deallocate_query();
+
+    if (force)
+    {
+        hard_exec(*this, conn_, query.c_str(),
+            "Cannot deallocate prepared statement.");
+    }
+    else
+    {
+        // The only consequence of failing to deallocate a statement is that
+        // it remains allocated until the end of the connection, so don't
+        // make the query which is about to be executed fail because of it.
+        postgresql_result(*this, PQexec(conn_, query.c_str()));
+    }
+}
+
+std::string postgresql_session_backend::make_deallocate_query()
+{
+    // All the statements are deallocated with a single round trip to the
+    // server by sending all the commands at once.
+    std::string query;
+    for (std::vector<std::string>::const_iterator
+            i = pendingDeallocations_.begin();
+        i != pendingDeallocations_.end(); ++i)
+    {
+        query += "DEALLOCATE " + *i + ";";
+    }
+
+    // Forget about these statements even if deallocating them fails, there
+    // is no point in retrying it again and again.
+    pendingDeallocations_.clear();
+
+    return query;
 }
 
 bool postgresql_session_backend::get_next_sequence_value(
@@ -110,6 +217,9 @@ bool postgresql_session_backend::get_next_sequence_value(
 
 void postgresql_session_backend::clean_up()
 {
+    // The prepared statements are destroyed together with the connection.
+    pendingDeallocations_.clear();
+
     if (0 != conn_)
     {
         PQfinish(conn_);
@@ -124,9 +234,17 @@ std::string postgresql_session_backend::get_next_statement_name()
     return nameBuf;
 }
 
+std::string postgresql_session_backend::get_next_cursor_name()
+{
+    char nameBuf[20] = { 0 }; // arbitrary length
+    sprintf(nameBuf, "cur_%d", ++cursorCount_);
+    return nameBuf;
+}
+
 postgresql_statement_backend * postgresql_session_backend::make_statement_backend()
 {
-    return new postgresql_statement_backend(*this, single_row_mode_);
+    return new postgresql_statement_backend(*this,
+        single_row_mode_, cursor_mode_);
 }
 
 postgresql_rowid_backend * postgresql_session_backend::make_rowid_backend()
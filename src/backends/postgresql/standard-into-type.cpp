@@ -90,6 +90,14 @@ void postgresql_standard_into_type_backend::post_fetch(
         case x_stdstring:
             exchange_type_cast<x_stdstring>(data_) = buf;
             break;
+        case x_stringref:
+            {
+                string_ref& r = exchange_type_cast<x_stringref>(data_);
+                r.data = buf;
+                r.size = PQgetlength(statement_.result_,
+                    statement_.currentRow_, pos);
+            }
+            break;
         case x_short:
             exchange_type_cast<x_short>(data_) = string_to_integer<short>(buf);
             break;
@@ -109,6 +117,9 @@ void postgresql_standard_into_type_backend::post_fetch(
             // attempt to parse the string and convert to std::tm
             parse_std_tm(buf, exchange_type_cast<x_stdtm>(data_));
             break;
+        case x_timestamp:
+            exchange_type_cast<x_timestamp>(data_).value = parse_timestamp(buf);
+            break;
         case x_rowid:
             {
                 // RowID is internally identical to unsigned long
@@ -13,6 +13,7 @@
 #include "soci/soci-platform.h"
 #include "soci-dtocstr.h"
 #include "soci-exchange-cast.h"
+#include "soci-mktime.h"
 #include <libpq/libpq-fs.h> // libpq
 #include <cctype>
 #include <cstdio>
@@ -65,7 +66,7 @@ void postgresql_standard_use_type_backend::pre_use(indicator const * ind)
             }
             break;
         case x_stdstring:
-            copy_from_string(exchange_type_cast<x_stdstring>(data_));
+            use_string(exchange_type_cast<x_stdstring>(data_));
             break;
         case x_short:
             {
@@ -111,10 +112,17 @@ void postgresql_standard_use_type_backend::pre_use(indicator const * ind)
                 std::size_t const bufSize = 80;
                 buf_ = new char[bufSize];
 
-                std::tm const& t = exchange_type_cast<x_stdtm>(data_);
-                snprintf(buf_, bufSize, "%d-%02d-%02d %02d:%02d:%02d",
-                    t.tm_year + 1900, t.tm_mon + 1, t.tm_mday,
-                    t.tm_hour, t.tm_min, t.tm_sec);
+                format_std_tm(buf_, bufSize,
+                    exchange_type_cast<x_stdtm>(data_));
+            }
+            break;
+        case x_timestamp:
+            {
+                std::size_t const bufSize = 80;
+                buf_ = new char[bufSize];
+
+                format_timestamp(buf_, bufSize,
+                    exchange_type_cast<x_timestamp>(data_).value);
             }
             break;
         case x_rowid:
@@ -146,10 +154,10 @@ void postgresql_standard_use_type_backend::pre_use(indicator const * ind)
             }
             break;
         case x_xmltype:
-            copy_from_string(exchange_type_cast<x_xmltype>(data_).value);
+            use_string(exchange_type_cast<x_xmltype>(data_).value);
             break;
         case x_longstring:
-            copy_from_string(exchange_type_cast<x_longstring>(data_).value);
+            use_string(exchange_type_cast<x_longstring>(data_).value);
             break;
 
         default:
@@ -186,9 +194,15 @@ void postgresql_standard_use_type_backend::clean_up()
 {
     if (buf_ != NULL)
     {
-        delete [] buf_;
+        if (ownBuf_)
+        {
+            delete [] buf_;
+        }
+
         buf_ = NULL;
     }
+
+    ownBuf_ = true;
 }
 
 void postgresql_standard_use_type_backend::copy_from_string(std::string const& s)
@@ -196,3 +210,12 @@ void postgresql_standard_use_type_backend::copy_from_string(std::string const& s
     buf_ = new char[s.size() + 1];
     std::strcpy(buf_, s.c_str());
 }
+
+void postgresql_standard_use_type_backend::use_string(std::string const& s)
+{
+    // The string is either the user object or the base value of a converted
+    // one and remains unchanged until the statement is executed, so there is
+    // no need to copy it: libpq only reads it, up to the terminating NUL.
+    buf_ = const_cast<char *>(s.c_str());
+    ownBuf_ = false;
+}
@@ -49,41 +49,141 @@ void throw_soci_error(PGconn * conn, const char * msg)
 
     throw soci_error(description);
 }
+
+// Switch the query which was just sent to the single-row mode or, if it is
+// supported by libpq and more than one row is fetched at once, to the chunked
+// mode, in which each result contains up to the given number of rows.
+void set_single_row_mode(PGconn * conn, int number)
+{
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    if (number > 1)
+    {
+        if (PQsetChunkedRowsMode(conn, number) != 1)
+        {
+            throw_soci_error(conn, "Cannot set chunked rows mode");
+        }
+
+        return;
+    }
+#else
+    static_cast<void>(number);
+#endif // LIBPQ_HAS_CHUNK_MODE
+
+    if (PQsetSingleRowMode(conn) != 1)
+    {
+        throw_soci_error(conn, "Cannot set single-row mode");
+    }
+}
+
+// check whether more results will follow the given one in single-row mode
+bool is_partial_result(PGresult const * result)
+{
+    ExecStatusType const status = PQresultStatus(result);
+
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    if (status == PGRES_TUPLES_CHUNK)
+    {
+        return true;
+    }
+#endif // LIBPQ_HAS_CHUNK_MODE
+
+    return status == PGRES_SINGLE_TUPLE;
+}
+
+// append the given rows of the source result to the destination one, which
+// must have the same columns
+void append_rows(PGresult * dest, PGresult const * src, int begin, int end)
+{
+    int const columns = PQnfields(src);
+    for (int row = begin; row != end; ++row)
+    {
+        int const destRow = PQntuples(dest);
+        for (int col = 0; col != columns; ++col)
+        {
+            bool const isNull = PQgetisnull(src, row, col) != 0;
+            int const ok = PQsetvalue(dest, destRow, col,
+                isNull ? NULL : PQgetvalue(src, row, col),
+                isNull ? -1 : PQgetlength(src, row, col));
+            if (ok != 1)
+            {
+                throw soci_error("Cannot store the fetched row.");
+            }
+        }
+    }
+}
 #endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
 
+// used to decide whether the query can be run through a server-side cursor,
+// DECLARE CURSOR only accepts SELECT and VALUES commands
+bool is_cursor_query(std::string const & query)
+{
+    std::string::const_iterator it = query.begin();
+    std::string::const_iterator const end = query.end();
+
+    while (it != end && (std::isspace(static_cast<unsigned char>(*it)) || *it == '('))
+    {
+        ++it;
+    }
+
+    std::string keyword;
+    while (it != end && std::isalpha(static_cast<unsigned char>(*it)))
+    {
+        keyword += static_cast<char>(std::tolower(static_cast<unsigned char>(*it)));
+        ++it;
+    }
+
+    return keyword == "select" || keyword == "values";
+}
+
 } // unnamed namespace
 
 postgresql_statement_backend::postgresql_statement_backend(
-    postgresql_session_backend &session, bool single_row_mode)
+    postgresql_session_backend &session, bool single_row_mode,
+    bool cursor_mode)
     : session_(session), single_row_mode_(single_row_mode),
-      result_(session, NULL),
+      cursor_mode_(cursor_mode),
+      result_(session, NULL), describeResult_(session, NULL),
       rowsAffectedBulk_(-1LL), justDescribed_(false),
+      describedForRow_(false),
+      singleRowsDone_(true),
+      isCursorQuery_(false), useCursor_(false), cursorWithHold_(false),
+      cursorTransaction_(0),
+      cursorExhausted_(false),
       hasIntoElements_(false), hasVectorIntoElements_(false),
       hasUseElements_(false), hasVectorUseElements_(false)
 {
-#ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
+#ifdef SOCI_POSTGRESQL_NOSINGLEROWMODE
   if (single_row_mode)
   {
     throw soci_error("Single row mode not supported in this version of the library");
   }
-#endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
+#endif // SOCI_POSTGRESQL_NOSINGLEROWMODE
 }
 
 postgresql_statement_backend::~postgresql_statement_backend()
 {
-    if (statementName_.empty() == false)
+    // Don't allow exceptions to escape from dtor. Suppressing them is not
+    // ideal, but terminating the program, as would happen if we're already
+    // unwinding the stack because of a previous exception, would be even
+    // worse. Failing to close the cursor must not prevent the statement
+    // from being deallocated though.
+    try
     {
-        try
+        close_cursor();
+    }
+    catch (...)
+    {
+    }
+
+    try
+    {
+        if (statementName_.empty() == false)
         {
             session_.deallocate_prepared_statement(statementName_);
         }
-        catch (...)
-        {
-            // Don't allow exceptions to escape from dtor. Suppressing them is
-            // not ideal, but terminating the program, as would happen if we're
-            // already unwinding the stack because of a previous exception,
-            // would be even worse.
-        }
+    }
+    catch (...)
+    {
     }
 }
 
@@ -98,7 +198,19 @@ void postgresql_statement_backend::clean_up()
     // potential new execution.
     rowsAffectedBulk_ = -1;
 
-    // nothing to do here
+#ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
+    if (singleRowsDone_ == false)
+    {
+        // Discard the rows which were not fetched, as the connection can't
+        // be used for anything else until all the results are retrieved.
+        singleRowsDone_ = true;
+
+        while (PGresult * res = PQgetResult(session_.conn_))
+        {
+            PQclear(res);
+        }
+    }
+#endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
 }
 
 void postgresql_statement_backend::prepare(std::string const & query,
@@ -202,6 +314,14 @@ void postgresql_statement_backend::prepare(std::string const & query,
         query_ += ss.str();
     }
 
+    isCursorQuery_ = cursor_mode_ && is_cursor_query(query_);
+    if (isCursorQuery_)
+    {
+        // DECLARE CURSOR needs the text of the query, so there is no point
+        // in preparing it separately
+        stType = st_one_time_query;
+    }
+
     if (stType == st_repeatable_query)
     {
         if (!statementName_.empty())
@@ -209,6 +329,10 @@ void postgresql_statement_backend::prepare(std::string const & query,
             throw soci_error("Shouldn't already have a prepared statement.");
         }
 
+        // This is a good opportunity to get rid of the statements which
+        // are not used any more.
+        session_.deallocate_pending_statements();
+
         // Holding the name temporarily in this var because
         // if it fails to prepare it we can't DEALLOCATE it.
         std::string statementName = session_.get_next_statement_name();
@@ -249,13 +373,6 @@ void postgresql_statement_backend::prepare(std::string const & query,
 statement_backend::exec_fetch_result
 postgresql_statement_backend::execute(int number)
 {
-#ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
-    if (single_row_mode_ && (number > 1))
-    {
-        throw soci_error("Bulk operations are not supported with single-row mode.");
-    }
-#endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
-
     // If the statement was "just described", then we know that
     // it was actually executed with all the use elements
     // already bound and pre-used. This means that the result of the
@@ -271,6 +388,8 @@ postgresql_statement_backend::execute(int number)
         // This object could have been already filled with data before.
         clean_up();
 
+        session_.deallocate_pending_statements();
+
         if ((number > 1) && hasIntoElements_)
         {
              throw soci_error(
@@ -292,6 +411,11 @@ postgresql_statement_backend::execute(int number)
              numberOfExecutions = hasUseElements_ ? 1 : number;
         }
 
+        // Queries without into elements are executed directly, as nothing
+        // would ever fetch from the cursor and the query would not be run.
+        useCursor_ = isCursorQuery_ && numberOfExecutions == 1 &&
+            (hasIntoElements_ || hasVectorIntoElements_ || describedForRow_);
+
         if ((useByPosBuffers_.empty() == false) ||
             (useByNameBuffers_.empty() == false))
         {
@@ -345,12 +469,17 @@ postgresql_statement_backend::execute(int number)
                     }
                 }
 
-                if (stType_ == st_repeatable_query)
+                if (useCursor_)
+                {
+                    // the rows will be retrieved from the cursor below
+                    declare_cursor(paramValues);
+                }
+                else if (stType_ == st_repeatable_query)
                 {
                     // this query was separately prepared
 
 #ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
-                    if (single_row_mode_)
+                    if (single_row_mode_ && numberOfExecutions == 1)
                     {
                         int result = PQsendQueryPrepared(session_.conn_,
                             statementName_.c_str(),
@@ -362,12 +491,7 @@ postgresql_statement_backend::execute(int number)
                                 "Cannot execute prepared query in single-row mode");
                         }
 
-                        result = PQsetSingleRowMode(session_.conn_);
-                        if (result != 1)
-                        {
-                            throw_soci_error(session_.conn_,
-                                "Cannot set singlerow mode");
-                        }
+                        set_single_row_mode(session_.conn_, number);
                     }
                     else
 #endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
@@ -386,7 +510,7 @@ postgresql_statement_backend::execute(int number)
                     // be executed as a one-time query
 
 #ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
-                    if (single_row_mode_)
+                    if (single_row_mode_ && numberOfExecutions == 1)
                     {
                         int result = PQsendQueryParams(session_.conn_, query_.c_str(),
                             static_cast<int>(paramValues.size()),
@@ -397,12 +521,7 @@ postgresql_statement_backend::execute(int number)
                                 "cannot execute query in single-row mode");
                         }
 
-                        result = PQsetSingleRowMode(session_.conn_);
-                        if (result != 1)
-                        {
-                            throw_soci_error(session_.conn_,
-                                "Cannot set singlerow mode");
-                        }
+                        set_single_row_mode(session_.conn_, number);
                     }
                     else
 #endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
@@ -442,7 +561,12 @@ postgresql_statement_backend::execute(int number)
         {
             // there are no use elements
             // - execute the query without parameter information
-            if (stType_ == st_repeatable_query)
+            if (useCursor_)
+            {
+                std::vector<char *> noParams;
+                declare_cursor(noParams);
+            }
+            else if (stType_ == st_repeatable_query)
             {
                 // this query was separately prepared
 
@@ -457,12 +581,7 @@ postgresql_statement_backend::execute(int number)
                             "Cannot execute prepared query in single-row mode");
                     }
 
-                    result = PQsetSingleRowMode(session_.conn_);
-                    if (result != 1)
-                    {
-                        throw_soci_error(session_.conn_,
-                            "Cannot set singlerow mode");
-                    }
+                    set_single_row_mode(session_.conn_, number);
                 }
                 else
 #endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
@@ -485,12 +604,7 @@ postgresql_statement_backend::execute(int number)
                             "Cannot execute query in single-row mode");
                     }
 
-                    result = PQsetSingleRowMode(session_.conn_);
-                    if (result != 1)
-                    {
-                        throw_soci_error(session_.conn_,
-                            "Cannot set single-row mode");
-                    }
+                    set_single_row_mode(session_.conn_, number);
                 }
                 else
 #endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
@@ -503,6 +617,33 @@ postgresql_statement_backend::execute(int number)
         }
     }
 
+    if (useCursor_)
+    {
+        // Notice that the cursor could have been already declared when
+        // describing the statement, but nothing was fetched from it yet.
+        if (number > 0)
+        {
+            fetch_from_cursor(number);
+        }
+        else
+        {
+            // execute(0) only opens the cursor, rows will be fetched later
+            numberOfRows_ = 0;
+        }
+
+        justDescribed_ = false;
+
+        currentRow_ = 0;
+        rowsToConsume_ = 0;
+
+        if (number == 0)
+        {
+            return ef_success;
+        }
+
+        return numberOfRows_ == 0 ? ef_no_data : fetch(number);
+    }
+
     bool process_result;
 #ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
     if (single_row_mode_)
@@ -516,6 +657,16 @@ postgresql_statement_backend::execute(int number)
         {
             PGresult * res = PQgetResult(session_.conn_);
             result_.reset(res);
+
+            singleRowsDone_ = false;
+            if (is_partial_result(res) == false)
+            {
+                // This is the final result (e.g. there are no rows at all or
+                // the query doesn't return them), but the connection is
+                // ready for the next query only after NULL is returned.
+                singleRowsDone_ = true;
+                wait_until_operation_complete(session_);
+            }
         }
 
         process_result = result_.check_for_data("Cannot execute query.");
@@ -563,13 +714,6 @@ postgresql_statement_backend::execute(int number)
 statement_backend::exec_fetch_result
 postgresql_statement_backend::fetch(int number)
 {
-#ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
-    if (single_row_mode_ && (number > 1))
-    {
-        throw soci_error("Bulk operations are not supported with single-row mode.");
-    }
-#endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
-
     // Note:
     // In the multi-row mode this function does not actually fetch anything from anywhere
     // - the data was already retrieved from the server in the execute()
@@ -581,85 +725,163 @@ postgresql_statement_backend::fetch(int number)
     // forward the "cursor" from the last fetch
     currentRow_ += rowsToConsume_;
 
-    if (currentRow_ >= numberOfRows_)
+    if (useCursor_)
     {
-#ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
-        if (single_row_mode_)
+        // In the cursor mode each FETCH retrieves at most the number of rows
+        // fitting into the into elements, keeping the client memory bounded.
+        if (currentRow_ >= numberOfRows_)
         {
-            PGresult* res = PQgetResult(session_.conn_);
-            result_.reset(res);
-
-            if (res == NULL)
+            if (cursorExhausted_)
             {
+                rowsToConsume_ = 0;
                 return ef_no_data;
             }
 
-            currentRow_ = 0;
-            rowsToConsume_ = 0;
-
-            numberOfRows_ = PQntuples(result_);
+            fetch_from_cursor(number);
             if (numberOfRows_ == 0)
             {
                 return ef_no_data;
             }
-            else
-            {
-                rowsToConsume_ = 1;
+        }
 
-                return ef_success;
-            }
+        if (currentRow_ + number > numberOfRows_)
+        {
+            // this can only happen if the into vectors were downsized or
+            // when the end of the rowset is reached
+            rowsToConsume_ = numberOfRows_ - currentRow_;
+
+            return cursorExhausted_ ? ef_no_data : ef_success;
         }
-        else
-#endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
+
+        rowsToConsume_ = number;
+
+        return ef_success;
+    }
+
+#ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
+    if (single_row_mode_)
+    {
+        if (currentRow_ + number > numberOfRows_)
         {
-            // default multi-row execution
+            // retrieve the rows from the server until the into elements can
+            // be filled completely or there are no more rows
+            fetch_single_rows(number);
+        }
 
-            // all rows were already consumed
+        if (number > numberOfRows_)
+        {
+            // all the remaining rows were retrieved
+            rowsToConsume_ = numberOfRows_;
 
             return ef_no_data;
         }
+
+        rowsToConsume_ = number;
+
+        return ef_success;
+    }
+#endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
+
+    if (currentRow_ >= numberOfRows_)
+    {
+        // all rows were already consumed
+
+        return ef_no_data;
     }
     else
     {
         if (currentRow_ + number > numberOfRows_)
         {
-#ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
-            if (single_row_mode_)
-            {
-                rowsToConsume_ = 1;
+            rowsToConsume_ = numberOfRows_ - currentRow_;
 
-                return ef_success;
-            }
-            else
-#endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
-            {
-                // default multi-row execution
+            // this simulates the behaviour of Oracle
+            // - when EOF is hit, we return ef_no_data even when there are
+            // actually some rows fetched
+            return ef_no_data;
+        }
+        else
+        {
+            rowsToConsume_ = number;
 
-                rowsToConsume_ = numberOfRows_ - currentRow_;
+            return ef_success;
+        }
+    }
+}
 
-                // this simulates the behaviour of Oracle
-                // - when EOF is hit, we return ef_no_data even when there are
-                // actually some rows fetched
-                return ef_no_data;
-            }
+#ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
+void postgresql_statement_backend::fetch_single_rows(int number)
+{
+    // The rows are accumulated in a single result, so that the into elements
+    // can use it exactly as in the default multi-row mode. This is done
+    // without copying anything if the server returns the rows in chunks of
+    // the requested size (or one by one if only one row is fetched).
+    postgresql_result batch(session_, NULL);
+    int batchRows = 0;
+
+    // start with the rows of the current result which were not consumed yet
+    if (currentRow_ < numberOfRows_)
+    {
+        if (currentRow_ == 0)
+        {
+            batch.reset(result_.release());
         }
         else
         {
-#ifndef SOCI_POSTGRESQL_NOSINGLEROWMODE
-            if (single_row_mode_)
+            batch.reset(PQcopyResult(result_, PG_COPYRES_ATTRS));
+            if (batch.get_result() == NULL)
             {
-                rowsToConsume_ = 1;
+                throw soci_error("Cannot allocate the result.");
             }
-            else
-#endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
+
+            append_rows(batch.get_result(), result_, currentRow_, numberOfRows_);
+        }
+
+        batchRows = numberOfRows_ - currentRow_;
+    }
+
+    while (batchRows < number && singleRowsDone_ == false)
+    {
+        postgresql_result next(session_, PQgetResult(session_.conn_));
+        if (next.get_result() == NULL)
+        {
+            singleRowsDone_ = true;
+            break;
+        }
+
+        next.check_for_data("Cannot fetch data.");
+
+        int const rows = PQntuples(next);
+        if (rows == 0)
+        {
+            // The terminating result doesn't contain any rows, but still
+            // describes the columns, keep it if nothing else was retrieved.
+            if (batch.get_result() == NULL)
             {
-                rowsToConsume_ = number;
+                batch.reset(next.release());
             }
 
-            return ef_success;
+            continue;
+        }
+
+        if (batch.get_result() == NULL)
+        {
+            batch.reset(next.release());
+        }
+        else
+        {
+            append_rows(batch.get_result(), next, 0, rows);
         }
+
+        batchRows += rows;
     }
+
+    result_.reset(batch.release());
+
+    currentRow_ = 0;
+    rowsToConsume_ = 0;
+    numberOfRows_ = batchRows;
 }
+#endif // !SOCI_POSTGRESQL_NOSINGLEROWMODE
 
 long long postgresql_statement_backend::get_affected_rows()
 {
@@ -702,6 +924,47 @@ std::string postgresql_statement_backend::rewrite_for_procedure_call(
 
 int postgresql_statement_backend::prepare_for_describe()
 {
+    // the description is followed by defining into elements for the columns,
+    // single ones for rows or vector ones for bulk ORM, so the statement can
+    // already use a cursor even though they are not defined yet
+    describedForRow_ = true;
+
+    if (stType_ == st_repeatable_query)
+    {
+        // The columns of a prepared statement can be found without executing
+        // it and don't change, so the description can be reused if the
+        // statement is described again, e.g. after rebinding it.
+        if (describeResult_.get_result() == NULL)
+        {
+            // there must be no pending results when sending a new command
+            clean_up();
+
+            describeResult_.reset(PQdescribePrepared(session_.conn_,
+                statementName_.c_str()));
+            describeResult_.check_for_errors(
+                "Cannot describe prepared statement.");
+        }
+
+        return PQnfields(describeResult_);
+    }
+
+    if (isCursorQuery_)
+    {
+        // Just declare the cursor and describe it, the rows will be fetched
+        // from it when the statement is executed.
+        execute(0);
+        justDescribed_ = true;
+
+        describeResult_.reset(PQdescribePortal(session_.conn_,
+            cursorName_.c_str()));
+        describeResult_.check_for_errors("Cannot describe cursor.");
+
+        return PQnfields(describeResult_);
+    }
+
+    // There is no point in describing a one-time query separately, as it's
+    // going to be executed immediately anyhow: do it right now and reuse its
+    // results in the following execute() call.
     execute(1);
     justDescribed_ = true;
 
@@ -715,7 +978,10 @@ void postgresql_statement_backend::describe_column(int colNum, data_type & type,
     // In postgresql_ column numbers start from 0
     int const pos = colNum - 1;
 
-    unsigned long const typeOid = PQftype(result_, pos);
+    PGresult const * const res = describeResult_.get_result() != NULL
+        ? describeResult_.get_result() : result_.get_result();
+
+    unsigned long const typeOid = PQftype(res, pos);
     switch (typeOid)
     {
     // Note: the following list of OIDs was taken from the pg_type table
@@ -764,8 +1030,8 @@ void postgresql_statement_backend::describe_column(int colNum, data_type & type,
 
     default:
     {
-        int form = PQfformat(result_, pos);
-        int size = PQfsize(result_, pos);
+        int form = PQfformat(res, pos);
+        int size = PQfsize(res, pos);
         if (form == 0 && size == -1)
         {
             type = dt_string;
@@ -775,13 +1041,111 @@ void postgresql_statement_backend::describe_column(int colNum, data_type & type,
             std::stringstream message;
             message << "unknown data type with typelem: " << typeOid
                 << " for colNum: " << colNum
-                << " with name: " << PQfname(result_, pos);
+                << " with name: " << PQfname(res, pos);
             throw soci_error(message.str());
         }
     }
     }
 
-    columnName = PQfname(result_, pos);
+    columnName = PQfname(res, pos);
+}
+
+void postgresql_statement_backend::declare_cursor(
+    std::vector<char *> & paramValues)
+{
+    close_cursor();
+
+    // Outside of a transaction block the cursor would be destroyed at the end
+    // of the implicit transaction of DECLARE itself, so it must be declared
+    // WITH HOLD, which makes the server materialize the results on commit.
+    cursorWithHold_ = PQtransactionStatus(session_.conn_) == PQTRANS_IDLE;
+    cursorTransaction_ = session_.transactionCount_;
+
+    std::string const cursorName = session_.get_next_cursor_name();
+
+    std::string query = "DECLARE " + cursorName + " NO SCROLL CURSOR ";
+    if (cursorWithHold_)
+    {
+        query += "WITH HOLD ";
+    }
+    query += "FOR ";
+    query += query_;
+
+    result_.reset(PQexecParams(session_.conn_, query.c_str(),
+            static_cast<int>(paramValues.size()), NULL,
+            paramValues.empty() ? NULL : &paramValues[0], NULL, NULL, 0));
+    result_.check_for_errors("Cannot declare cursor.");
+
+    cursorName_ = cursorName;
+    cursorExhausted_ = false;
+}
+
+void postgresql_statement_backend::fetch_from_cursor(int number)
+{
+    std::ostringstream ss;
+    ss << "FETCH FORWARD " << number << " FROM " << cursorName_;
+
+    result_.reset(PQexec(session_.conn_, ss.str().c_str()));
+    result_.check_for_data("Cannot fetch from cursor.");
+
+    currentRow_ = 0;
+    rowsToConsume_ = 0;
+    numberOfRows_ = PQntuples(result_);
+
+    if (numberOfRows_ < number)
+    {
+        // The cursor is known to exist here, so close it right now instead
+        // of keeping the server-side resources until the next execution.
+        cursorExhausted_ = true;
+
+        std::string const query = "CLOSE " + cursorName_;
+        cursorName_.clear();
+
+        postgresql_result(session_, PQexec(session_.conn_, query.c_str()))
+            .check_for_errors("Cannot close cursor.");
+    }
+}
+
+void postgresql_statement_backend::close_cursor()
+{
+    if (cursorName_.empty())
+    {
+        return;
+    }
+
+    std::string const cursorName = cursorName_;
+    cursorName_.clear();
+
+    switch (PQtransactionStatus(session_.conn_))
+    {
+    case PQTRANS_IDLE:
+        if (cursorWithHold_ == false)
+        {
+            // the cursor went away together with its transaction
+            return;
+        }
+        break;
+
+    case PQTRANS_INTRANS:
+        if (cursorWithHold_ == false &&
+            cursorTransaction_ != session_.transactionCount_)
+        {
+            // The transaction of the cursor was finished and a new one
+            // started since it was declared and closing a cursor which
+            // doesn't exist any more would abort the current transaction.
+            return;
+        }
+        break;
+
+    default:
+        // Nothing can be done while in a failed transaction (the cursor will
+        // be destroyed by its rollback) or if the connection is not usable.
+        return;
+    }
+
+    std::string const query = "CLOSE " + cursorName;
+    postgresql_result(session_, PQexec(session_.conn_, query.c_str()))
+        .check_for_errors("Cannot close cursor.");
 }
 
 postgresql_standard_into_type_backend *
@@ -12,6 +12,7 @@
 #include "soci-mktime.h"
 #include "common.h"
 #include "soci/type-wrappers.h"
+#include "soci/timestamp.h"
 #include <libpq/libpq-fs.h> // libpq
 #include <cctype>
 #include <cstdio>
@@ -79,6 +80,9 @@ void postgresql_vector_into_type_backend::post_fetch(bool gotData, indicator * i
 
         int const endRow = statement_.currentRow_ + statement_.rowsToConsume_;
 
+        // used for parsing all std::tm values
+        std_tm_parser tmParser;
+
         for (int curRow = statement_.currentRow_, i = begin_;
              curRow != endRow; ++curRow, ++i)
         {
@@ -115,6 +119,14 @@ void postgresql_vector_into_type_backend::post_fetch(bool gotData, indicator * i
             case x_stdstring:
                 set_invector_<std::string>(data_, i, buf);
                 break;
+            case x_stringref:
+                {
+                    string_ref r;
+                    r.data = buf;
+                    r.size = PQgetlength(statement_.result_, curRow, pos);
+                    set_invector_(data_, i, r);
+                }
+                break;
             case x_short:
                 {
                     short const val = string_to_integer<short>(buf);
@@ -150,11 +162,17 @@ void postgresql_vector_into_type_backend::post_fetch(bool gotData, indicator * i
                 {
                     // attempt to parse the string and convert to std::tm
                     std::tm t = std::tm();
-                    parse_std_tm(buf, t);
+                    tmParser.parse(buf, t);
 
                     set_invector_(data_, i, t);
                 }
                 break;
+            case x_timestamp:
+                {
+                    timestamp const ts(parse_timestamp(buf));
+                    set_invector_(data_, i, ts);
+                }
+                break;
             case x_xmltype:
                 set_invector_wrappers_<xml_type, std::string>(data_, i, buf);
                 break;
@@ -217,9 +235,15 @@ void postgresql_vector_into_type_backend::resize(std::size_t sz)
         case x_stdstring:
             resizevector_<std::string>(data_, sz);
             break;
+        case x_stringref:
+            resizevector_<string_ref>(data_, sz);
+            break;
         case x_stdtm:
             resizevector_<std::tm>(data_, sz);
             break;
+        case x_timestamp:
+            resizevector_<timestamp>(data_, sz);
+            break;
         case x_xmltype:
             resizevector_<xml_type>(data_, sz);
             break;
@@ -285,9 +309,15 @@ std::size_t postgresql_vector_into_type_backend::full_size()
     case x_stdstring:
         sz = get_vector_size<std::string>(data_);
         break;
+    case x_stringref:
+        sz = get_vector_size<string_ref>(data_);
+        break;
     case x_stdtm:
         sz = get_vector_size<std::tm>(data_);
         break;
+    case x_timestamp:
+        sz = get_vector_size<timestamp>(data_);
+        break;
     case x_xmltype:
         sz = get_vector_size<xml_type>(data_);
         break;
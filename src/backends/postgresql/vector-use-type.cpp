@@ -9,8 +9,10 @@
 #include "soci/soci-platform.h"
 #include "soci/postgresql/soci-postgresql.h"
 #include "soci-dtocstr.h"
+#include "soci-mktime.h"
 #include "common.h"
 #include "soci/type-wrappers.h"
+#include "soci/timestamp.h"
 #include <libpq/libpq-fs.h> // libpq
 #include <cctype>
 #include <cstdio>
@@ -52,6 +54,9 @@ void postgresql_vector_use_type_backend::bind_by_name_bulk(
 
 void postgresql_vector_use_type_backend::pre_use(indicator const * ind)
 {
+    // release the buffers of the previous execution, if any
+    clean_up();
+
     std::size_t vend;
 
     if (end_ != NULL && *end_ != 0)
@@ -94,8 +99,8 @@ void postgresql_vector_use_type_backend::pre_use(indicator const * ind)
                         = static_cast<std::vector<std::string> *>(data_);
                     std::vector<std::string> & v = *pv;
 
-                    buf = new char[v[i].size() + 1];
-                    std::strcpy(buf, v[i].c_str());
+                    // the strings are used directly, see clean_up()
+                    buf = const_cast<char *>(v[i].c_str());
                 }
                 break;
             case x_short:
@@ -167,9 +172,19 @@ void postgresql_vector_use_type_backend::pre_use(indicator const * ind)
                     std::size_t const bufSize = 80;
                     buf = new char[bufSize];
 
-                    snprintf(buf, bufSize, "%d-%02d-%02d %02d:%02d:%02d",
-                        v[i].tm_year + 1900, v[i].tm_mon + 1, v[i].tm_mday,
-                        v[i].tm_hour, v[i].tm_min, v[i].tm_sec);
+                    format_std_tm(buf, bufSize, v[i]);
+                }
+                break;
+            case x_timestamp:
+                {
+                    std::vector<timestamp> * pv
+                        = static_cast<std::vector<timestamp> *>(data_);
+                    std::vector<timestamp> & v = *pv;
+
+                    std::size_t const bufSize = 80;
+                    buf = new char[bufSize];
+
+                    format_timestamp(buf, bufSize, v[i].value);
                 }
                 break;
             case x_xmltype:
@@ -178,8 +193,7 @@ void postgresql_vector_use_type_backend::pre_use(indicator const * ind)
                         = static_cast<std::vector<xml_type> *>(data_);
                     std::vector<xml_type> & v = *pv;
 
-                    buf = new char[v[i].value.size() + 1];
-                    std::strcpy(buf, v[i].value.c_str());
+                    buf = const_cast<char *>(v[i].value.c_str());
                 }
                 break;
             case x_longstring:
@@ -188,8 +202,7 @@ void postgresql_vector_use_type_backend::pre_use(indicator const * ind)
                         = static_cast<std::vector<long_string> *>(data_);
                     std::vector<long_string> & v = *pv;
 
-                    buf = new char[v[i].value.size() + 1];
-                    std::strcpy(buf, v[i].value.c_str());
+                    buf = const_cast<char *>(v[i].value.c_str());
                 }
                 break;
 
@@ -265,6 +278,9 @@ std::size_t postgresql_vector_use_type_backend::full_size()
     case x_stdtm:
         sz = get_vector_size<std::tm>(data_);
         break;
+    case x_timestamp:
+        sz = get_vector_size<timestamp>(data_);
+        break;
     case x_xmltype:
         sz = get_vector_size<xml_type>(data_);
         break;
@@ -280,9 +296,16 @@ std::size_t postgresql_vector_use_type_backend::full_size()
 
 void postgresql_vector_use_type_backend::clean_up()
 {
-    std::size_t const bsize = buffers_.size();
-    for (std::size_t i = 0; i != bsize; ++i)
+    // The buffers of string values point to the strings in the used vector,
+    // which are only read by libpq, so they don't need to be freed.
+    if (type_ != x_stdstring && type_ != x_xmltype && type_ != x_longstring)
     {
-        delete [] buffers_[i];
+        std::size_t const bsize = buffers_.size();
+        for (std::size_t i = 0; i != bsize; ++i)
+        {
+            delete [] buffers_[i];
+        }
     }
+
+    buffers_.clear();
 }
@@ -10,22 +10,82 @@
 
 #include <algorithm>
 #include <cstring>
+#include <sstream>
 
 using namespace soci;
+using namespace sqlite_api;
+
+namespace // anonymous
+{
+
+void throw_blob_error(sqlite_api::sqlite3 *conn, int res, char const *op)
+{
+    std::ostringstream ss;
+    ss << "sqlite3_blob_backend::" << op << ": " << sqlite3_errmsg(conn);
+    throw sqlite3_soci_error(ss.str(), res);
+}
+
+} // namespace anonymous
 
 sqlite3_blob_backend::sqlite3_blob_backend(sqlite3_session_backend &session)
-    : session_(session), buf_(0), len_(0)
+    : session_(session), buf_(0), len_(0), handle_(0)
 {
 }
 
 sqlite3_blob_backend::~sqlite3_blob_backend()
 {
+    if (handle_)
+    {
+        sqlite3_blob_close(handle_);
+        handle_ = 0;
+    }
+
+    if (buf_)
+    {
+        delete [] buf_;
+        buf_ = 0;
+        len_ = 0;
+    }
+}
+
+void sqlite3_blob_backend::open(std::string const &table,
+    std::string const &column, long long rowid, bool readWrite,
+    std::string const &dbname)
+{
+    close();
+
     if (buf_)
     {
         delete [] buf_;
         buf_ = 0;
         len_ = 0;
     }
+
+    int const res = sqlite3_blob_open(session_.conn_, dbname.c_str(),
+        table.c_str(), column.c_str(), rowid, readWrite ? 1 : 0, &handle_);
+    if (res != SQLITE_OK)
+    {
+        // the handle is set to NULL unless it's SQLITE_MISUSE
+        sqlite3_blob_close(handle_);
+        handle_ = 0;
+        throw_blob_error(session_.conn_, res, "open");
+    }
+
+    len_ = static_cast<std::size_t>(sqlite3_blob_bytes(handle_));
+}
+
+void sqlite3_blob_backend::close()
+{
+    if (handle_)
+    {
+        int const res = sqlite3_blob_close(handle_);
+        handle_ = 0;
+        len_ = 0;
+        if (res != SQLITE_OK)
+        {
+            throw_blob_error(session_.conn_, res, "close");
+        }
+    }
 }
 
 std::size_t sqlite3_blob_backend::get_len()
@@ -36,6 +96,11 @@ std::size_t sqlite3_blob_backend::get_len()
 std::size_t sqlite3_blob_backend::read(
     std::size_t offset, char * buf, std::size_t toRead)
 {
+    if (offset >= len_)
+    {
+        return 0;
+    }
+
     size_t r = toRead;
 
     // make sure that we don't try to read
@@ -45,16 +110,51 @@ std::size_t sqlite3_blob_backend::read(
         r = len_ - offset;
     }
 
-    memcpy(buf, buf_ + offset, r);
+    if (handle_)
+    {
+        int const res = sqlite3_blob_read(handle_, buf,
+            static_cast<int>(r), static_cast<int>(offset));
+        if (res != SQLITE_OK)
+        {
+            throw_blob_error(session_.conn_, res, "read");
+        }
+    }
+    else
+    {
+        memcpy(buf, buf_ + offset, r);
+    }
 
     return r;
 }
 
+std::size_t sqlite3_blob_backend::read_from_start(
+    char * buf, std::size_t toRead, std::size_t offset)
+{
+    return read(offset, buf, toRead);
+}
+
 
 std::size_t sqlite3_blob_backend::write(
     std::size_t offset, char const * buf,
     std::size_t toWrite)
 {
+    if (handle_)
+    {
+        if (offset + toWrite > len_)
+        {
+            throw soci_error("Cannot write past the end of an open SQLite blob.");
+        }
+
+        int const res = sqlite3_blob_write(handle_, buf,
+            static_cast<int>(toWrite), static_cast<int>(offset));
+        if (res != SQLITE_OK)
+        {
+            throw_blob_error(session_.conn_, res, "write");
+        }
+
+        return len_;
+    }
+
     const char* oldBuf = buf_;
     std::size_t oldLen = len_;
     len_ = (std::max)(len_, offset + toWrite);
@@ -74,10 +174,21 @@ std::size_t sqlite3_blob_backend::write(
     return len_;
 }
 
+std::size_t sqlite3_blob_backend::write_from_start(
+    char const * buf, std::size_t toWrite, std::size_t offset)
+{
+    return write(offset, buf, toWrite);
+}
+
 
 std::size_t sqlite3_blob_backend::append(
     char const * buf, std::size_t toWrite)
 {
+    if (handle_)
+    {
+        throw soci_error("Cannot append to an open SQLite blob.");
+    }
+
     const char* oldBuf = buf_;
 
     buf_ = new char[len_ + toWrite];
@@ -96,6 +207,11 @@ std::size_t sqlite3_blob_backend::append(
 
 void sqlite3_blob_backend::trim(std::size_t newLen)
 {
+    if (handle_)
+    {
+        throw soci_error("Cannot trim an open SQLite blob.");
+    }
+
     const char* oldBuf = buf_;
     len_ = newLen;
 
@@ -108,6 +224,8 @@ void sqlite3_blob_backend::trim(std::size_t newLen)
 
 std::size_t sqlite3_blob_backend::set_data(char const *buf, std::size_t toWrite)
 {
+    close();
+
     if (buf_)
     {
         delete [] buf_;
@@ -9,6 +9,7 @@
 #define SOCI_SQLITE3_COMMON_H_INCLUDED
 
 #include "soci/error.h"
+#include "soci-cstrtod.h"
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
@@ -37,46 +38,21 @@ void resize_vector(void *p, std::size_t sz)
 template <typename T>
 T string_to_integer(char const * buf)
 {
-    long long t(0);
-    int n(0);
-    int const converted = std::sscanf(buf, "%" LL_FMT_FLAGS "d%n", &t, &n);
-    if (converted == 1 && static_cast<std::size_t>(n) == std::strlen(buf))
+    T t;
+    if (cstring_to_integer(buf, t) == false)
     {
-        // successfully converted to long long
-        // and no other characters were found in the buffer
-
-        const T max = (std::numeric_limits<T>::max)();
-        const T min = (std::numeric_limits<T>::min)();
-        if (t <= static_cast<long long>(max) &&
-            t >= static_cast<long long>(min))
-        {
-            return static_cast<T>(t);
-        }
+        throw soci_error("Cannot convert data.");
     }
 
-    throw soci_error("Cannot convert data.");
+    return t;
 }
 
 // helper function for parsing unsigned integers
 template <typename T>
 T string_to_unsigned_integer(char const * buf)
 {
-    unsigned long long t(0);
-    int n(0);
-    int const converted = std::sscanf(buf, "%" LL_FMT_FLAGS "u%n", &t, &n);
-    if (converted == 1 && static_cast<std::size_t>(n) == std::strlen(buf))
-    {
-        // successfully converted to unsigned long long
-        // and no other characters were found in the buffer
-
-        T const max = (std::numeric_limits<T>::max)();
-        if (t <= static_cast<unsigned long long>(max))
-        {
-            return static_cast<T>(t);
-        }
-    }
-
-    throw soci_error("Cannot convert data.");
+    // cstring_to_integer() handles both signed and unsigned types
+    return string_to_integer<T>(buf);
 }
 
 }}} // namespace soci::details::sqlite3
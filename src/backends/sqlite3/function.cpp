@@ -0,0 +1,146 @@
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define SOCI_SQLITE3_SOURCE
+#include "soci/sqlite3/soci-sqlite3.h"
+#include "soci-mktime.h"
+
+#include <sstream>
+#include <string>
+
+using namespace soci;
+using namespace soci::details;
+using namespace sqlite_api;
+
+sqlite3_value * sqlite3_function_args::get_native(int pos) const
+{
+    if (pos < 0 || pos >= argc_)
+    {
+        std::ostringstream ss;
+        ss << "Invalid user-defined function argument position " << pos
+           << " (there are " << argc_ << " arguments).";
+        throw soci_error(ss.str());
+    }
+
+    return argv_[pos];
+}
+
+bool sqlite3_function_args::is_null(int pos) const
+{
+    return sqlite3_value_type(get_native(pos)) == SQLITE_NULL;
+}
+
+void sqlite3_function_args::get_value(int pos, int &value) const
+{
+    value = sqlite3_value_int(get_native(pos));
+}
+
+void sqlite3_function_args::get_value(int pos, long long &value) const
+{
+    value = sqlite3_value_int64(get_native(pos));
+}
+
+void sqlite3_function_args::get_value(int pos, unsigned long long &value) const
+{
+    value = static_cast<unsigned long long>(sqlite3_value_int64(get_native(pos)));
+}
+
+void sqlite3_function_args::get_value(int pos, double &value) const
+{
+    value = sqlite3_value_double(get_native(pos));
+}
+
+void sqlite3_function_args::get_value(int pos, std::string &value) const
+{
+    sqlite3_value * const arg = get_native(pos);
+
+    // the text must be retrieved before its size, as it can be converted
+    char const * const text =
+        reinterpret_cast<char const *>(sqlite3_value_text(arg));
+    if (text)
+        value.assign(text, sqlite3_value_bytes(arg));
+    else
+        value.clear();
+}
+
+void sqlite3_function_args::get_value(int pos, std::tm &value) const
+{
+    char const * const text =
+        reinterpret_cast<char const *>(sqlite3_value_text(get_native(pos)));
+    parse_std_tm(text ? text : "", value);
+}
+
+void sqlite3_function_result::set(int value)
+{
+    sqlite3_result_int(ctx_, value);
+}
+
+void sqlite3_function_result::set(long long value)
+{
+    sqlite3_result_int64(ctx_, value);
+}
+
+void sqlite3_function_result::set(unsigned long long value)
+{
+    sqlite3_result_int64(ctx_, static_cast<sqlite3_int64>(value));
+}
+
+void sqlite3_function_result::set(double value)
+{
+    sqlite3_result_double(ctx_, value);
+}
+
+void sqlite3_function_result::set(std::string const &value)
+{
+    sqlite3_result_text(ctx_, value.c_str(), static_cast<int>(value.size()),
+                        SQLITE_TRANSIENT);
+}
+
+void sqlite3_function_result::set(char const *value)
+{
+    sqlite3_result_text(ctx_, value, -1, SQLITE_TRANSIENT);
+}
+
+void sqlite3_function_result::set(std::tm const &value)
+{
+    char buf[20];
+    int const len = format_std_tm(buf, sizeof(buf), value);
+    sqlite3_result_text(ctx_, buf, len, SQLITE_TRANSIENT);
+}
+
+void sqlite3_function_result::set_null()
+{
+    sqlite3_result_null(ctx_);
+}
+
+void sqlite3_function_result::set_error(std::string const &message)
+{
+    sqlite3_result_error(ctx_, message.c_str(), static_cast<int>(message.size()));
+}
+
+int sqlite3_session_backend::get_function_flags(bool deterministic)
+{
+    int flags = SQLITE_UTF8;
+#ifdef SQLITE_DETERMINISTIC
+    if (deterministic)
+        flags |= SQLITE_DETERMINISTIC;
+#else
+    (void)deterministic;
+#endif
+    return flags;
+}
+
+void sqlite3_session_backend::check_create_function(int res,
+    std::string const & name)
+{
+    if (res != SQLITE_OK)
+    {
+        std::ostringstream ss;
+        ss << "Cannot create function \"" << name << "\": "
+           << sqlite3_errmsg(conn_);
+        throw sqlite3_soci_error(ss.str(), res);
+    }
+}
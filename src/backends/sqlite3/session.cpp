@@ -10,6 +10,7 @@
 
 #include "soci/connection-parameters.h"
 
+#include <cctype>
 #include <sstream>
 #include <string>
 
@@ -38,6 +39,36 @@ void execude_hardcoded(sqlite_api::sqlite3* conn, char const* const query, char
     }
 }
 
+// the values of the connection parameters are used in the pragmas as is, so
+// only accept the valid ones
+std::string check_journal_mode(std::string const& val)
+{
+    std::string mode;
+    for (std::string::const_iterator it = val.begin(); it != val.end(); ++it)
+    {
+        mode += static_cast<char>(std::tolower(static_cast<unsigned char>(*it)));
+    }
+
+    if (mode != "delete" && mode != "truncate" && mode != "persist" &&
+        mode != "memory" && mode != "wal" && mode != "off")
+    {
+        throw soci_error("Invalid journal_mode value: \"" + val + "\".");
+    }
+
+    return mode;
+}
+
+std::string check_mmap_size(std::string const& val)
+{
+    if (val.empty() ||
+        val.find_first_not_of("0123456789") != std::string::npos)
+    {
+        throw soci_error("Invalid mmap_size value: \"" + val + "\".");
+    }
+
+    return val;
+}
+
 void check_sqlite_err(sqlite_api::sqlite3* conn, int res, char const* const errMsg)
 {
     if (SQLITE_OK != res)
@@ -50,15 +81,121 @@ void check_sqlite_err(sqlite_api::sqlite3* conn, int res, char const* const errM
     }
 }
 
+// copy the main database of src to dst, both connections must be valid,
+// waiting for at most busyTimeout milliseconds if one of them is locked
+void backup_database(sqlite_api::sqlite3* dst, sqlite_api::sqlite3* src,
+    int pagesPerStep, int busyTimeout, sqlite3_backup_callback* callback)
+{
+    sqlite3_backup* const backup = sqlite3_backup_init(dst, "main", src, "main");
+    if (!backup)
+    {
+        std::ostringstream ss;
+        ss << "Cannot start backup: " << sqlite3_errmsg(dst);
+        throw sqlite3_soci_error(ss.str(), sqlite3_errcode(dst));
+    }
+
+    bool aborted = false;
+    int busyCode = SQLITE_OK;
+    int waited = 0;
+    for (;;)
+    {
+        int const res = sqlite3_backup_step(backup, pagesPerStep);
+        if (res == SQLITE_BUSY || res == SQLITE_LOCKED)
+        {
+            // the source or destination database is used by another
+            // connection, retry later unless we have already waited enough
+            if (waited >= busyTimeout)
+            {
+                busyCode = res;
+                break;
+            }
+
+            sqlite3_sleep(10);
+            waited += 10;
+            continue;
+        }
+
+        if (res != SQLITE_OK && res != SQLITE_DONE)
+            break;
+
+        // the step succeeded, the timeout applies to each wait separately
+        waited = 0;
+
+        if (callback && !callback->on_progress(sqlite3_backup_remaining(backup),
+                                               sqlite3_backup_pagecount(backup)))
+        {
+            aborted = res != SQLITE_DONE;
+            break;
+        }
+
+        if (res == SQLITE_DONE)
+            break;
+    }
+
+    // this returns the error of the last step, if any
+    int const res = sqlite3_backup_finish(backup);
+    if (res != SQLITE_OK)
+    {
+        std::ostringstream ss;
+        ss << "Backup failed: " << sqlite3_errmsg(dst);
+        throw sqlite3_soci_error(ss.str(), res);
+    }
+
+    // busy errors are not reported by sqlite3_backup_finish()
+    if (busyCode != SQLITE_OK)
+    {
+        std::ostringstream ss;
+        ss << "Backup failed: "
+           << (busyCode == SQLITE_BUSY ? "database is locked"
+                                       : "database table is locked");
+        throw sqlite3_soci_error(ss.str(), busyCode);
+    }
+
+    if (aborted)
+    {
+        throw soci_error("Backup aborted.");
+    }
+}
+
+// open the other database for a backup operation and perform it
+void backup_file(sqlite_api::sqlite3* conn, std::string const& filename,
+    bool toFile, int pagesPerStep, int busyTimeout,
+    sqlite3_backup_callback* callback)
+{
+    sqlite_api::sqlite3* file = NULL;
+    int const flags = toFile ? SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE
+                             : SQLITE_OPEN_READONLY;
+    int const res = sqlite3_open_v2(filename.c_str(), &file, flags, NULL);
+    check_sqlite_err(file, res, "Cannot open the database for backup. ");
+
+    try
+    {
+        if (toFile)
+            backup_database(file, conn, pagesPerStep, busyTimeout, callback);
+        else
+            backup_database(conn, file, pagesPerStep, busyTimeout, callback);
+    }
+    catch (...)
+    {
+        sqlite3_close(file);
+        throw;
+    }
+
+    sqlite3_close(file);
+}
+
 } // namespace anonymous
 
 
 sqlite3_session_backend::sqlite3_session_backend(
     connection_parameters const & parameters)
+    : stmtCacheSize_(16), busyTimeout_(0)
 {
     int timeout = 0;
     int connection_flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
     std::string synchronous;
+    std::string journalMode;
+    std::string mmapSize;
     std::string const & connectString = parameters.get_connect_string();
     std::string dbname(connectString);
     std::stringstream ssconn(connectString);
@@ -104,6 +241,24 @@ sqlite3_session_backend::sqlite3_session_backend(
         {
             connection_flags |=  SQLITE_OPEN_SHAREDCACHE;
         }
+        else if ("readonly" == key && "true" == val)
+        {
+            connection_flags &= ~(SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+            connection_flags |= SQLITE_OPEN_READONLY;
+        }
+        else if ("journal_mode" == key)
+        {
+            journalMode = check_journal_mode(val);
+        }
+        else if ("mmap_size" == key)
+        {
+            mmapSize = check_mmap_size(val);
+        }
+        else if ("statement_cache" == key)
+        {
+            std::istringstream converter(val);
+            converter >> stmtCacheSize_;
+        }
     }
 
     int res = sqlite3_open_v2(dbname.c_str(), &conn_, connection_flags, NULL);
@@ -116,9 +271,24 @@ sqlite3_session_backend::sqlite3_session_backend(
         execude_hardcoded(conn_, query.c_str(), errMsg.c_str());
     }
 
-    res = sqlite3_busy_timeout(conn_, timeout * 1000);
+    busyTimeout_ = timeout * 1000;
+    res = sqlite3_busy_timeout(conn_, busyTimeout_);
     check_sqlite_err(conn_, res, "Failed to set busy timeout for connection. ");
 
+    if (!journalMode.empty())
+    {
+        std::string const query("pragma journal_mode=" + journalMode);
+        std::string const errMsg("Query failed: " + query);
+        execude_hardcoded(conn_, query.c_str(), errMsg.c_str());
+    }
+
+    if (!mmapSize.empty())
+    {
+        std::string const query("pragma mmap_size=" + mmapSize);
+        std::string const errMsg("Query failed: " + query);
+        execude_hardcoded(conn_, query.c_str(), errMsg.c_str());
+    }
+
 }
 
 sqlite3_session_backend::~sqlite3_session_backend()
@@ -151,7 +321,73 @@ bool sqlite3_session_backend::get_last_insert_id(
 
 void sqlite3_session_backend::clean_up()
 {
+    // sqlite3_close() fails if there are any unfinalized statements left.
+    for (statement_cache::iterator it = stmtCache_.begin();
+         it != stmtCache_.end(); ++it)
+    {
+        sqlite3_finalize(it->second);
+    }
+    stmtCache_.clear();
+
+#if SQLITE_VERSION_NUMBER >= 3007014
+    // Unlike sqlite3_close(), this doesn't fail if a blob is still open, the
+    // connection is only closed once it is closed too.
+    sqlite3_close_v2(conn_);
+#else
+    // Blobs opened with sqlite3_blob_backend::open() must be closed first.
     sqlite3_close(conn_);
+#endif
+}
+
+sqlite3_stmt * sqlite3_session_backend::acquire_statement(
+    std::string const & query)
+{
+    for (statement_cache::iterator it = stmtCache_.begin();
+         it != stmtCache_.end(); ++it)
+    {
+        if (it->first == query)
+        {
+            sqlite3_stmt * const stmt = it->second;
+            stmtCache_.erase(it);
+            return stmt;
+        }
+    }
+
+    return NULL;
+}
+
+void sqlite3_session_backend::release_statement(
+    std::string const & query, sqlite3_stmt * stmt)
+{
+    if (stmtCacheSize_ == 0)
+    {
+        sqlite3_finalize(stmt);
+        return;
+    }
+
+    // The result of the last step, if it failed, was already reported.
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+
+    stmtCache_.push_front(std::make_pair(query, stmt));
+
+    if (stmtCache_.size() > stmtCacheSize_)
+    {
+        sqlite3_finalize(stmtCache_.back().second);
+        stmtCache_.pop_back();
+    }
+}
+
+void sqlite3_session_backend::load_from(std::string const & filename,
+    int pagesPerStep, sqlite3_backup_callback * callback)
+{
+    backup_file(conn_, filename, false, pagesPerStep, busyTimeout_, callback);
+}
+
+void sqlite3_session_backend::save_to(std::string const & filename,
+    int pagesPerStep, sqlite3_backup_callback * callback)
+{
+    backup_file(conn_, filename, true, pagesPerStep, busyTimeout_, callback);
 }
 
 sqlite3_statement_backend * sqlite3_session_backend::make_statement_backend()
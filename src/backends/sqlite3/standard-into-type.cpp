@@ -96,6 +96,16 @@ void sqlite3_standard_into_type_backend::post_fetch(bool gotData,
                 break;
             }
 
+            case x_stringref:
+            {
+                string_ref &r = exchange_type_cast<x_stringref>(data_);
+                r.data = reinterpret_cast<const char*>(
+                    sqlite3_column_text(statement_.stmt_, pos)
+                );
+                r.size = sqlite3_column_bytes(statement_.stmt_, pos);
+                break;
+            }
+
             case x_short:
                 exchange_type_cast<x_short>(data_)
                     = static_cast<exchange_type_traits<x_short>::value_type >(
@@ -140,6 +150,16 @@ void sqlite3_standard_into_type_backend::post_fetch(bool gotData,
                 break;
             }
 
+            case x_timestamp:
+            {
+                const char *buf = reinterpret_cast<const char*>(
+                    sqlite3_column_text(statement_.stmt_, pos)
+                );
+                exchange_type_cast<x_timestamp>(data_).value
+                    = parse_timestamp(buf ? buf : "");
+                break;
+            }
+
             case x_rowid:
             {
                 // RowID is internally identical to unsigned long
@@ -12,7 +12,9 @@
 #include "soci/blob.h"
 #include "soci-dtocstr.h"
 #include "soci-exchange-cast.h"
+#include "soci-mktime.h"
 // std
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -74,13 +76,12 @@ void sqlite3_standard_use_type_backend::bind_by_name(std::string const& name,
 
 void sqlite3_standard_use_type_backend::pre_use(indicator const * ind)
 {
-    statement_.useData_.resize(1);
     int const pos = position_ - 1;
 
-    if (statement_.useData_[0].size() < static_cast<std::size_t>(position_))
-    {
-        statement_.useData_[0].resize(position_);
-    }
+    // make sure that the single row can accomodate the number of columns
+    std::size_t const columns = (std::max)(statement_.useData_.columns(),
+        static_cast<std::size_t>(position_));
+    statement_.useData_.resize(1, columns);
 
     sqlite3_column &col = statement_.useData_[0][pos];
 
@@ -138,16 +139,21 @@ void sqlite3_standard_use_type_backend::pre_use(indicator const * ind)
         case x_stdtm:
         {
             col.type_ = dt_date;
-            static const size_t bufSize = 20;
             std::tm &t = exchange_type_cast<x_stdtm>(data_);
 
-            col.buffer_.data_ = new char[bufSize];
+            col.buffer_.data_ = dateBuf_;
+            col.buffer_.size_ = format_std_tm(dateBuf_, sizeof(dateBuf_), t);
+            break;
+        }
+
+        case x_timestamp:
+        {
+            col.type_ = dt_date;
+            timestamp const &ts = exchange_type_cast<x_timestamp>(data_);
+
+            col.buffer_.data_ = dateBuf_;
             col.buffer_.size_
-                = snprintf(
-                    col.buffer_.data_, bufSize, "%d-%02d-%02d %02d:%02d:%02d",
-                    t.tm_year + 1900, t.tm_mon + 1, t.tm_mday,
-                    t.tm_hour, t.tm_min, t.tm_sec
-                );
+                = format_timestamp(dateBuf_, sizeof(dateBuf_), ts.value);
             break;
         }
 
@@ -167,6 +173,10 @@ void sqlite3_standard_use_type_backend::pre_use(indicator const * ind)
             col.type_ = dt_blob;
             blob *b = static_cast<blob *>(data_);
             sqlite3_blob_backend *bbe = static_cast<sqlite3_blob_backend *>(b->get_backend());
+            if (bbe->is_open())
+            {
+                throw soci_error("Open SQLite blobs can't be used as parameters.");
+            }
 
             col.buffer_.constData_ = bbe->get_buffer();
             col.buffer_.size_ = bbe->get_len();
@@ -192,22 +202,9 @@ void sqlite3_standard_use_type_backend::post_use(
     //          and executed a query that attempted to modified it)
     // - false: the modification should be propagated to the given object.
     // ...
-
-    // clean up the working buffer, it might be allocated anew in
-    // the next run of preUse
-    clean_up();
 }
 
 void sqlite3_standard_use_type_backend::clean_up()
 {
-    if (type_ != x_stdtm)
-        return;
-
-    sqlite3_column &col = statement_.useData_[0][position_ - 1];
-
-    if (col.isNull_ || !col.buffer_.data_)
-        return;
-
-    delete[] col.buffer_.data_;
-    col.buffer_.data_ = NULL;
+    // ...
 }
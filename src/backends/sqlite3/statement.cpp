@@ -23,12 +23,161 @@ using namespace soci;
 using namespace soci::details;
 using namespace sqlite_api;
 
+namespace // anonymous
+{
+
+// Executing a statement once for every row in autocommit mode commits each
+// row separately, which is very slow when every commit is synced to disk.
+// This wraps all the executions in a savepoint, which is released even if
+// one of them fails, so that the rows inserted before the failure are kept
+// exactly as if they had been committed one by one.
+class bulk_savepoint
+{
+public:
+    bulk_savepoint(sqlite_api::sqlite3 * conn, bool needed)
+        : conn_(conn), active_(false)
+    {
+        // don't interfere with the transactions started by the user
+        if (needed == false || sqlite3_get_autocommit(conn_) == 0)
+            return;
+
+        char * zErrMsg = 0;
+        int const res = sqlite3_exec(conn_, "SAVEPOINT soci_bulk", 0, 0, &zErrMsg);
+        if (res != SQLITE_OK)
+        {
+            std::ostringstream ss;
+            ss << "sqlite3_statement_backend::bind_and_execute: "
+               << zErrMsg;
+            sqlite3_free(zErrMsg);
+            throw sqlite3_soci_error(ss.str(), res);
+        }
+
+        active_ = true;
+    }
+
+    ~bulk_savepoint()
+    {
+        if (active_ == false)
+            return;
+
+        // the savepoint doesn't exist any more if the failure rolled back
+        // the transaction, so just ignore any error here
+        sqlite3_exec(conn_, "RELEASE soci_bulk", 0, 0, 0);
+    }
+
+    void release()
+    {
+        if (active_ == false)
+            return;
+
+        char * zErrMsg = 0;
+        int const res = sqlite3_exec(conn_, "RELEASE soci_bulk", 0, 0, &zErrMsg);
+        if (res != SQLITE_OK)
+        {
+            std::ostringstream ss;
+            ss << "sqlite3_statement_backend::bind_and_execute: "
+               << zErrMsg;
+            sqlite3_free(zErrMsg);
+            throw sqlite3_soci_error(ss.str(), res);
+        }
+
+        active_ = false;
+    }
+
+private:
+    sqlite_api::sqlite3 * const conn_;
+    bool active_;
+
+    SOCI_NOT_COPYABLE(bulk_savepoint)
+};
+
+} // namespace anonymous
+
+void sqlite3_recordset::resize(std::size_t rows, std::size_t columns)
+{
+    if (columns == columns_)
+    {
+        cells_.resize(rows * columns);
+    }
+    else
+    {
+        std::vector<sqlite3_column> cells(rows * columns);
+
+        std::size_t const copyRows = (std::min)(rows, rows_);
+        std::size_t const copyColumns = (std::min)(columns, columns_);
+        for (std::size_t r = 0; r != copyRows; ++r)
+        {
+            std::copy(&cells_[r * columns_], &cells_[r * columns_] + copyColumns,
+                &cells[r * columns]);
+        }
+
+        cells_.swap(cells);
+        columns_ = columns;
+    }
+
+    rows_ = rows;
+}
+
+sqlite3_arena::~sqlite3_arena()
+{
+    for (std::size_t i = 0; i != blocks_.size(); ++i)
+    {
+        delete [] blocks_[i].data_;
+    }
+}
+
+char * sqlite3_arena::allocate(std::size_t size)
+{
+    if (blocks_.empty() || blocks_.back().size_ - used_ < size)
+    {
+        // the blocks grow geometrically to keep their number small
+        std::size_t const minBlockSize = 4096;
+        std::size_t blockSize = blocks_.empty() ? minBlockSize
+                                                : 2 * blocks_.back().size_;
+        if (blockSize < size)
+        {
+            blockSize = size;
+        }
+
+        block b;
+        b.data_ = new char[blockSize];
+        b.size_ = blockSize;
+        blocks_.push_back(b);
+        used_ = 0;
+    }
+
+    char * const p = blocks_.back().data_ + used_;
+    used_ += size;
+    return p;
+}
+
+void sqlite3_arena::reset()
+{
+    if (blocks_.size() > 1)
+    {
+        // replace all blocks with a single one big enough for all the data,
+        // so that loading the same amount of data again needs no allocations
+        std::size_t total = 0;
+        for (std::size_t i = 0; i != blocks_.size(); ++i)
+        {
+            total += blocks_[i].size_;
+            delete [] blocks_[i].data_;
+        }
+
+        blocks_.resize(1);
+        blocks_[0].data_ = new char[total];
+        blocks_[0].size_ = total;
+    }
+
+    used_ = 0;
+}
+
 sqlite3_statement_backend::sqlite3_statement_backend(
     sqlite3_session_backend &session)
     : session_(session)
     , stmt_(0)
     , dataCache_()
-    , useData_(0)
+    , useData_()
     , databaseReady_(false)
     , boundByName_(false)
     , boundByPos_(false)
@@ -47,7 +196,7 @@ void sqlite3_statement_backend::clean_up()
 
     if (stmt_)
     {
-        sqlite3_finalize(stmt_);
+        session_.release_statement(query_, stmt_);
         stmt_ = 0;
         databaseReady_ = false;
     }
@@ -58,12 +207,40 @@ void sqlite3_statement_backend::prepare(std::string const & query,
 {
     clean_up();
 
+    // the cached column descriptions are only valid for the same query
+    if (query != query_)
+    {
+        columns_.clear();
+        query_ = query;
+    }
+
+    stmt_ = session_.acquire_statement(query);
+    if (stmt_)
+    {
+        databaseReady_ = true;
+        return;
+    }
+
     char const* tail = 0; // unused;
+#if SQLITE_VERSION_NUMBER >= 3020000
+    // Statements kept in the session cache are long-lived, let SQLite know
+    // about it so that it doesn't allocate them from the lookaside memory.
+    unsigned const flags = session_.stmtCacheSize_ != 0
+                         ? SQLITE_PREPARE_PERSISTENT
+                         : 0;
+    int const res = sqlite3_prepare_v3(session_.conn_,
+                              query.c_str(),
+                              static_cast<int>(query.size()),
+                              flags,
+                              &stmt_,
+                              &tail);
+#else
     int const res = sqlite3_prepare_v2(session_.conn_,
                               query.c_str(),
                               static_cast<int>(query.size()),
                               &stmt_,
                               &tail);
+#endif
     if (res != SQLITE_OK)
     {
         char const* zErrMsg = sqlite3_errmsg(session_.conn_);
@@ -123,13 +300,10 @@ sqlite3_statement_backend::load_rowset(int totalRows)
     }
     else
     {
-        // make the vector big enough to hold the data we need
-        dataCache_.resize(totalRows);
-        for (sqlite3_recordset::iterator it = dataCache_.begin(),
-            end = dataCache_.end(); it != end; ++it)
-        {
-            (*it).resize(numCols);
-        }
+        // make the cache big enough to hold the data we need, the strings
+        // and blobs of the previously loaded rows are not needed any more
+        dataCache_.resize(totalRows, numCols);
+        dataArena_.reset();
 
         for (i = 0; i < totalRows && databaseReady_; ++i)
         {
@@ -162,7 +336,7 @@ sqlite3_statement_backend::load_rowset(int totalRows)
                         case dt_string:
                         case dt_date:
                             col.buffer_.size_ = sqlite3_column_bytes(stmt_, c);
-                            col.buffer_.data_ = new char[col.buffer_.size_+1];
+                            col.buffer_.data_ = dataArena_.allocate(col.buffer_.size_+1);
                             memcpy(col.buffer_.data_, sqlite3_column_text(stmt_, c), col.buffer_.size_+1);
                             break;
 
@@ -181,7 +355,7 @@ sqlite3_statement_backend::load_rowset(int totalRows)
 
                         case dt_blob:
                             col.buffer_.size_ = sqlite3_column_bytes(stmt_, c);
-                            col.buffer_.data_ = (col.buffer_.size_ > 0 ? new char[col.buffer_.size_] : NULL);
+                            col.buffer_.data_ = (col.buffer_.size_ > 0 ? dataArena_.allocate(col.buffer_.size_) : NULL);
                             memcpy(col.buffer_.data_, sqlite3_column_blob(stmt_, c), col.buffer_.size_);
                             break;
 
@@ -200,8 +374,8 @@ sqlite3_statement_backend::load_rowset(int totalRows)
             }
         }
     }
-    // if we read less than requested then shrink the vector
-    dataCache_.resize(i);
+    // if we read less than requested then shrink the cache
+    dataCache_.resize(i, numCols);
 
     return retVal;
 }
@@ -247,11 +421,14 @@ sqlite3_statement_backend::bind_and_execute(int number)
     rowsAffectedBulk_ = -1;
 
     int const rows = static_cast<int>(useData_.size());
+
+    bulk_savepoint savepoint(session_.conn_, rows > 1);
+
     for (int row = 0; row < rows; ++row)
     {
         sqlite3_reset(stmt_);
 
-        int const totalPositions = static_cast<int>(useData_[0].size());
+        int const totalPositions = static_cast<int>(useData_.columns());
         for (int pos = 1; pos <= totalPositions; ++pos)
         {
             int bindRes = SQLITE_OK;
@@ -264,12 +441,11 @@ sqlite3_statement_backend::bind_and_execute(int number)
             {
                 switch (col.type_)
                 {
+                    // the use elements keep the data alive until the next
+                    // execution, so it doesn't need to be copied by SQLite
                     case dt_string:
-                        bindRes = sqlite3_bind_text(stmt_, pos, col.buffer_.constData_, static_cast<int>(col.buffer_.size_), NULL);
-                        break;
-                    
                     case dt_date:
-                        bindRes = sqlite3_bind_text(stmt_, pos, col.buffer_.constData_, static_cast<int>(col.buffer_.size_), SQLITE_TRANSIENT);
+                        bindRes = sqlite3_bind_text(stmt_, pos, col.buffer_.constData_, static_cast<int>(col.buffer_.size_), SQLITE_STATIC);
                         break;
 
                     case dt_double:
@@ -286,7 +462,7 @@ sqlite3_statement_backend::bind_and_execute(int number)
                         break;
 
                     case dt_blob:
-                        bindRes = sqlite3_bind_blob(stmt_, pos, col.buffer_.constData_, static_cast<int>(col.buffer_.size_), NULL);
+                        bindRes = sqlite3_bind_blob(stmt_, pos, col.buffer_.constData_, static_cast<int>(col.buffer_.size_), SQLITE_STATIC);
                         break;
 
                     case dt_xml:
@@ -310,10 +486,21 @@ sqlite3_statement_backend::bind_and_execute(int number)
         }
 
         databaseReady_=true; // Mark sqlite engine is ready to perform sqlite3_step
-        retVal = load_one(); // execute each bound line
+        try
+        {
+            retVal = load_one(); // execute each bound line
+        }
+        catch (...)
+        {
+            // preserve the number of rows affected so far.
+            rowsAffectedBulk_ = rowsAffectedBulkTemp;
+            throw;
+        }
         rowsAffectedBulkTemp += get_affected_rows();
     }
 
+    savepoint.release();
+
     rowsAffectedBulk_ = rowsAffectedBulkTemp;
     return retVal;
 }
@@ -461,6 +648,26 @@ static sqlite3_data_type_map get_data_type_map()
     return m;
 }
 
+// Map the declared type to the SOCI type corresponding to its affinity, see
+// https://www.sqlite.org/datatype3.html#determination_of_column_affinity
+static data_type get_affinity_data_type(std::string const & declType)
+{
+    if (declType.find("int") != std::string::npos)
+        return dt_integer;
+
+    if (declType.find("char") != std::string::npos ||
+        declType.find("clob") != std::string::npos ||
+        declType.find("text") != std::string::npos)
+        return dt_string;
+
+    // columns with blob affinity (or none) can hold anything
+    if (declType.empty() || declType.find("blob") != std::string::npos)
+        return dt_string;
+
+    // real or numeric affinity
+    return dt_double;
+}
+
 void sqlite3_statement_backend::describe_column(int colNum, data_type & type,
                                                 std::string & columnName)
 {
@@ -513,32 +720,15 @@ void sqlite3_statement_backend::describe_column(int colNum, data_type & type,
         return;
     }
 
-    // try to get it from the weak ass type system
-
-    // total hack - execute the statment once to get the column types
-    // then clear so it can be executed again
-    sqlite3_step(stmt_);
-
-    int const sqlite3_type = sqlite3_column_type(stmt_, colNum-1);
-    switch (sqlite3_type)
-    {
-    case SQLITE_INTEGER:
-        type = dt_integer;
-        break;
-    case SQLITE_FLOAT:
-        type = dt_double;
-        break;
-    case SQLITE_BLOB:
-    case SQLITE_TEXT:
-        type = dt_string;
-        break;
-    default:
-        type = dt_string;
-        break;
-    }
-    coldef.type_ = type;
+    // The declared type is not one of the known ones, so use the same rules
+    // as SQLite itself uses to determine the column affinity instead of
+    // executing the statement to look at the values: this would execute it
+    // twice and without the parameters bound to it yet.
+    std::string affinityType = declType;
+    std::transform(affinityType.begin(), affinityType.end(),
+                   affinityType.begin(), tolower);
 
-    sqlite3_reset(stmt_);
+    coldef.type_ = type = get_affinity_data_type(affinityType);
 }
 
 sqlite3_standard_into_type_backend *
@@ -15,6 +15,7 @@
 #include "soci/blob.h"
 #include "soci/rowid.h"
 #include "soci/soci-platform.h"
+#include "soci/timestamp.h"
 #include "soci/sqlite3/soci-sqlite3.h"
 #include "soci-cstrtod.h"
 #include "soci-mktime.h"
@@ -98,6 +99,9 @@ void sqlite3_vector_into_type_backend::post_fetch(bool gotData, indicator * ind)
         return;
     }
 
+    // used for parsing all std::tm values
+    std_tm_parser tmParser;
+
     int const endRow = static_cast<int>(statement_.dataCache_.size());
     for (int i = 0; i < endRow; ++i)
     {
@@ -226,7 +230,7 @@ void sqlite3_vector_into_type_backend::post_fetch(bool gotData, indicator * ind)
                     {
                         // attempt to parse the string and convert to std::tm
                         std::tm t = std::tm();
-                        parse_std_tm(col.buffer_.constData_, t);
+                        tmParser.parse(col.buffer_.constData_, t);
 
                         set_in_vector(data_, i, t);
                         break;
@@ -244,28 +248,35 @@ void sqlite3_vector_into_type_backend::post_fetch(bool gotData, indicator * ind)
                 break;
             }
 
-            default:
-                throw soci_error("Into element used with non-supported type.");
-        }
+            case x_timestamp:
+            {
+                switch (col.type_)
+                {
+                    case dt_date:
+                    case dt_string:
+                    case dt_blob:
+                    {
+                        timestamp const ts(
+                            parse_timestamp(col.buffer_.constData_));
 
-        // cleanup data
-        switch (col.type_)
-        {
-            case dt_date:
-            case dt_string:
-            case dt_blob:
-                delete[] col.buffer_.data_;
-                col.buffer_.data_ = NULL;
-                break;
+                        set_in_vector(data_, i, ts);
+                        break;
+                    }
 
-            case dt_double:
-            case dt_integer:
-            case dt_long_long:
-            case dt_unsigned_long_long:
+                    case dt_double:
+                    case dt_integer:
+                    case dt_long_long:
+                    case dt_unsigned_long_long:
+                        throw soci_error("Into element used with non-convertible type.");
+
+                    case dt_xml:
+                        throw soci_error("XML data type is not supported");
+                };
                 break;
+            }
 
-            case dt_xml:
-                throw soci_error("XML data type is not supported");
+            default:
+                throw soci_error("Into element used with non-supported type.");
         }
     }
 }
@@ -302,6 +313,9 @@ void sqlite3_vector_into_type_backend::resize(std::size_t sz)
     case x_stdtm:
         resize_vector<std::tm>(data_, sz);
         break;
+    case x_timestamp:
+        resize_vector<timestamp>(data_, sz);
+        break;
     default:
         throw soci_error("Into vector element used with non-supported type.");
     }
@@ -340,6 +354,9 @@ std::size_t sqlite3_vector_into_type_backend::size()
     case x_stdtm:
         sz = get_vector_size<std::tm>(data_);
         break;
+    case x_timestamp:
+        sz = get_vector_size<timestamp>(data_);
+        break;
     default:
         throw soci_error("Into vector element used with non-supported type.");
     }
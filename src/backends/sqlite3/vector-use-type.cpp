@@ -9,9 +9,12 @@
 #include "soci-exchange-cast.h"
 #include "soci/soci-platform.h"
 #include "soci/sqlite3/soci-sqlite3.h"
+#include "soci/timestamp.h"
 #include "soci-dtocstr.h"
+#include "soci-mktime.h"
 #include "common.h"
 // std
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -70,18 +73,25 @@ void sqlite3_vector_use_type_backend::pre_use(indicator const * ind)
 {
     std::size_t const vsize = size();
 
-    // make sure that useData can hold enough rows
-    if (statement_.useData_.size() != vsize)
-        statement_.useData_.resize(vsize);
+    // make sure that useData can hold enough rows and that each row can
+    // accomodate the number of columns
+    std::size_t const columns = (std::max)(statement_.useData_.columns(),
+        static_cast<std::size_t>(position_));
+    statement_.useData_.resize(vsize, columns);
 
     int const pos = position_ - 1;
 
+    // dates are formatted in a single buffer holding all of them, which
+    // stays valid until the next execution as they're bound without copying
+    std::size_t dateSize = 0;
+    if (type_ == x_stdtm)
+        dateSize = 20;
+    else if (type_ == x_timestamp)
+        dateSize = 27;
+    dateBuf_.resize(vsize * dateSize);
+
     for (size_t i = 0; i != vsize; ++i)
     {
-        // make sure that each row can accomodate the number of columns
-        if (statement_.useData_[i].size() < static_cast<std::size_t>(position_))
-            statement_.useData_[i].resize(position_);
-
         sqlite3_column &col = statement_.useData_[i][pos];
 
         // the data in vector can be either i_ok or i_null
@@ -139,15 +149,22 @@ void sqlite3_vector_use_type_backend::pre_use(indicator const * ind)
             case x_stdtm:
             {
                 std::tm &tm = (*static_cast<std::vector<exchange_type_traits<x_stdtm>::value_type> *>(data_))[i];
-                static const size_t bufSize = 20;
 
                 col.type_ = dt_date;
-                col.buffer_.data_ = new char[bufSize];
+                col.buffer_.data_ = &dateBuf_[i * dateSize];
+                col.buffer_.size_
+                    = format_std_tm(col.buffer_.data_, dateSize, tm);
+                break;
+            }
+
+            case x_timestamp:
+            {
+                timestamp const &ts = (*static_cast<std::vector<exchange_type_traits<x_timestamp>::value_type> *>(data_))[i];
+
+                col.type_ = dt_date;
+                col.buffer_.data_ = &dateBuf_[i * dateSize];
                 col.buffer_.size_
-                    = snprintf(col.buffer_.data_, bufSize, "%d-%02d-%02d %02d:%02d:%02d",
-                        tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
-                        tm.tm_hour, tm.tm_min, tm.tm_sec
-                    );
+                    = format_timestamp(col.buffer_.data_, dateSize, ts.value);
                 break;
             }
 
@@ -188,6 +205,9 @@ std::size_t sqlite3_vector_use_type_backend::size()
     case x_stdtm:
         sz = get_vector_size<std::tm>(data_);
         break;
+    case x_timestamp:
+        sz = get_vector_size<timestamp>(data_);
+        break;
     default:
         throw soci_error("Use vector element used with non-supported type.");
     }
@@ -197,19 +217,5 @@ std::size_t sqlite3_vector_use_type_backend::size()
 
 void sqlite3_vector_use_type_backend::clean_up()
 {
-    if (type_ != x_stdtm)
-        return;
-
-    int const pos = position_ - 1;
-
-    for (sqlite3_recordset::iterator iter = statement_.useData_.begin(), last = statement_.useData_.end();
-        iter != last; ++iter)
-    {
-        sqlite3_column &col = (*iter)[pos];
-
-        if (col.isNull_)
-            continue;
-
-        delete[] col.buffer_.data_;
-    }
+    // ...
 }
@@ -0,0 +1,74 @@
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define SOCI_SQLITE3_SOURCE
+#include "soci/sqlite3/soci-sqlite3.h"
+#include "soci/session.h"
+#include "soci/into.h"
+
+#include <cctype>
+#include <cstring>
+#include <string>
+
+using namespace soci;
+
+namespace // anonymous
+{
+
+std::size_t check_readers(std::size_t readers)
+{
+    if (readers == 0)
+    {
+        throw soci_error("At least one reader connection is required.");
+    }
+
+    return readers;
+}
+
+} // namespace anonymous
+
+sqlite3_wal_pool::sqlite3_wal_pool(std::string const & dbname,
+    std::size_t readers, std::string const & options)
+    : writer_(1), readers_(check_readers(readers))
+{
+    std::string const connectString = "dbname=\"" + dbname + "\" " + options;
+
+    session & writer = writer_.at(0);
+    writer.open(soci::sqlite3, connectString + " journal_mode=wal");
+
+    // the journal mode is not changed if it isn't supported, e.g. in memory
+    std::string mode;
+    writer << "pragma journal_mode", into(mode);
+    if (mode != "wal")
+    {
+        throw soci_error("Cannot use WAL journal mode for \"" + dbname + "\".");
+    }
+
+    for (std::size_t i = 0; i != readers; ++i)
+    {
+        readers_.at(i).open(soci::sqlite3, connectString + " readonly=true");
+    }
+}
+
+connection_pool & sqlite3_wal_pool::route(std::string const & query)
+{
+    std::string::size_type const start = query.find_first_not_of(" \t\r\n(");
+    if (start != std::string::npos && query.size() - start >= 6)
+    {
+        char keyword[7] = { 0 };
+        for (int i = 0; i != 6; ++i)
+        {
+            keyword[i] = static_cast<char>(std::tolower(query[start + i]));
+        }
+
+        if (std::strcmp(keyword, "select") == 0)
+        {
+            return readers_;
+        }
+    }
+
+    return writer_;
+}
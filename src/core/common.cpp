@@ -8,9 +8,12 @@
 
 #define SOCI_SOURCE
 #include "soci/error.h"
+#include "soci/timestamp.h"
 #include "soci-mktime.h"
 #include <climits>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 
 namespace // anonymous
@@ -40,16 +43,103 @@ int parse10(char const * & p1, char * & p2)
     }
 }
 
-} // namespace anonymous
+// helper function for parsing exactly the given number of decimal digits
+bool parse_digits(char const * & p, int count, int & value)
+{
+    int v = 0;
+    for (int n = 0; n != count; ++n, ++p)
+    {
+        if (*p < '0' || *p > '9')
+        {
+            return false;
+        }
 
-void soci::details::parse_std_tm(char const * buf, std::tm & t)
+        v = v * 10 + (*p - '0');
+    }
+
+    value = v;
+    return true;
+}
+
+// parse the optional fractional part of seconds, only microseconds are kept
+char const * parse_fraction(char const * p, int & microseconds)
+{
+    microseconds = 0;
+    if (*p == '.')
+    {
+        int scale = 100000;
+        for (++p; *p >= '0' && *p <= '9'; ++p)
+        {
+            microseconds += (*p - '0') * scale;
+            scale /= 10;
+        }
+    }
+
+    return p;
+}
+
+// parse the date in "YYYY-MM-DD" format, advancing p past it on success
+bool parse_fixed_date(char const * & p, int & year, int & month, int & day)
+{
+    return parse_digits(p, 4, year) && *p++ == '-' &&
+           parse_digits(p, 2, month) && *p++ == '-' &&
+           parse_digits(p, 2, day);
+}
+
+// parse the time in "HH:MM:SS[.ffffff]" format, ignoring anything after it
+bool parse_fixed_time(char const * p,
+    int & hour, int & minute, int & second, int & microseconds)
+{
+    if (parse_digits(p, 2, hour) && *p++ == ':' &&
+        parse_digits(p, 2, minute) && *p++ == ':' &&
+        parse_digits(p, 2, second))
+    {
+        parse_fraction(p, microseconds);
+        return true;
+    }
+
+    return false;
+}
+
+// parse the date and/or time in any format accepted by parse_std_tm()
+void parse_ymdhms(char const * buf,
+    int & year, int & month, int & day,
+    int & hour, int & minute, int & second, int & microseconds)
 {
+    microseconds = 0;
+
+    // try the standard formats first
+    char const * p = buf;
+    if (parse_fixed_date(p, year, month, day))
+    {
+        hour = minute = second = 0;
+
+        if (*p == '\0')
+        {
+            return;
+        }
+
+        if ((*p == ' ' || *p == 'T') &&
+                parse_fixed_time(p + 1, hour, minute, second, microseconds))
+        {
+            return;
+        }
+    }
+    else if (parse_fixed_time(buf, hour, minute, second, microseconds))
+    {
+        year = 1900;
+        month = 1;
+        day = 1;
+        return;
+    }
+
+    // fall back to the generic parsing for all the other formats
     char const * p1 = buf;
     char * p2;
     char separator;
     int a, b, c;
-    int year = 1900, month = 1, day = 1;
-    int hour = 0, minute = 0, second = 0;
+    year = 1900, month = 1, day = 1;
+    hour = 0, minute = 0, second = 0;
 
     a = parse10(p1, p2);
     separator = *p2;
@@ -67,6 +157,8 @@ void soci::details::parse_std_tm(char const * buf, std::tm & t)
         hour   = parse10(p1, p2);
         minute = parse10(p1, p2);
         second = parse10(p1, p2);
+
+        parse_fraction(p2, microseconds);
     }
     else
     {
@@ -86,8 +178,185 @@ void soci::details::parse_std_tm(char const * buf, std::tm & t)
             hour = a;
             minute = b;
             second = c;
+
+            parse_fraction(p2, microseconds);
+        }
+    }
+}
+
+// write the value, which must be in 0..10^digits range, with leading zeros
+char * format_digits(char * p, int value, int digits)
+{
+    for (int n = digits - 1; n >= 0; --n)
+    {
+        p[n] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+
+    return p + digits;
+}
+
+} // namespace anonymous
+
+void soci::details::parse_std_tm(char const * buf, std::tm & t)
+{
+    int microseconds;
+    parse_std_tm(buf, t, microseconds);
+}
+
+void soci::details::parse_std_tm(char const * buf, std::tm & t,
+    int & microseconds)
+{
+    int year, month, day, hour, minute, second;
+    parse_ymdhms(buf, year, month, day, hour, minute, second, microseconds);
+
+    tm_from_ymdhms(t, year, month, day, hour, minute, second);
+}
+
+void soci::details::std_tm_parser::parse(char const * buf, std::tm & t)
+{
+    int microseconds;
+    parse(buf, t, microseconds);
+}
+
+void soci::details::std_tm_parser::parse(char const * buf, std::tm & t,
+    int & microseconds)
+{
+    char const * p = buf;
+    int year, month, day;
+    if (parse_fixed_date(p, year, month, day) &&
+            (*p == '\0' || *p == ' ' || *p == 'T'))
+    {
+        if (hasLastDate_ == false ||
+                std::memcmp(buf, lastDate_, sizeof(lastDate_)) != 0)
+        {
+            tm_from_ymdhms(lastTm_, year, month, day, 0, 0, 0);
+            std::memcpy(lastDate_, buf, sizeof(lastDate_));
+            hasLastDate_ = true;
         }
+
+        int hour = 0, minute = 0, second = 0;
+        microseconds = 0;
+        if (*p == '\0' ||
+                parse_fixed_time(p + 1, hour, minute, second, microseconds))
+        {
+            // the time of day can be used as is if it doesn't need to be
+            // normalized, which would change the date
+            if (hour < 24 && minute < 60 && second < 60)
+            {
+                t = lastTm_;
+                t.tm_hour = hour;
+                t.tm_min = minute;
+                t.tm_sec = second;
+                return;
+            }
+        }
+    }
+
+    parse_std_tm(buf, t, microseconds);
+}
+
+int soci::details::format_std_tm(char * buf, std::size_t bufSize,
+    std::tm const & t, int microseconds)
+{
+    int const year = t.tm_year + 1900;
+    int const month = t.tm_mon + 1;
+
+    int const len = microseconds != 0 ? 26 : 19;
+
+    if (static_cast<std::size_t>(len) < bufSize &&
+        year >= 0 && year <= 9999 &&
+        month >= 0 && month <= 99 &&
+        t.tm_mday >= 0 && t.tm_mday <= 99 &&
+        t.tm_hour >= 0 && t.tm_hour <= 99 &&
+        t.tm_min >= 0 && t.tm_min <= 99 &&
+        t.tm_sec >= 0 && t.tm_sec <= 99 &&
+        microseconds >= 0 && microseconds <= 999999)
+    {
+        char * p = buf;
+        p = format_digits(p, year, 4);
+        *p++ = '-';
+        p = format_digits(p, month, 2);
+        *p++ = '-';
+        p = format_digits(p, t.tm_mday, 2);
+        *p++ = ' ';
+        p = format_digits(p, t.tm_hour, 2);
+        *p++ = ':';
+        p = format_digits(p, t.tm_min, 2);
+        *p++ = ':';
+        p = format_digits(p, t.tm_sec, 2);
+        if (microseconds != 0)
+        {
+            *p++ = '.';
+            p = format_digits(p, microseconds, 6);
+        }
+        *p = '\0';
+
+        return len;
     }
 
-    mktime_from_ymdhms(t, year, month, day, hour, minute, second);
+    // unusual values (e.g. negative years) or too small buffer
+    if (microseconds != 0)
+    {
+        return snprintf(buf, bufSize, "%04d-%02d-%02d %02d:%02d:%02d.%06d",
+            year, month, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec,
+            microseconds);
+    }
+
+    return snprintf(buf, bufSize, "%04d-%02d-%02d %02d:%02d:%02d",
+        year, month, t.tm_mday, t.tm_hour, t.tm_min, t.tm_sec);
+}
+
+long long soci::details::parse_timestamp(char const * buf)
+{
+    int year, month, day, hour, minute, second, microseconds;
+    parse_ymdhms(buf, year, month, day, hour, minute, second, microseconds);
+
+    long long const seconds = days_from_ymd(year, month, day) * 86400LL
+        + hour * 3600LL + minute * 60LL + second;
+
+    return seconds * 1000000 + microseconds;
+}
+
+int soci::details::format_timestamp(char * buf, std::size_t bufSize,
+    long long value)
+{
+    int microseconds;
+    std::tm const t = timestamp_to_tm(timestamp(value), &microseconds);
+
+    return format_std_tm(buf, bufSize, t, microseconds);
+}
+
+soci::timestamp soci::timestamp_from_tm(std::tm const & t, int microseconds)
+{
+    long long const seconds =
+        details::days_from_ymd(t.tm_year + 1900, t.tm_mon + 1, t.tm_mday)
+            * 86400LL
+        + t.tm_hour * 3600LL + t.tm_min * 60LL + t.tm_sec;
+
+    return timestamp(seconds * 1000000 + microseconds);
+}
+
+std::tm soci::timestamp_to_tm(timestamp ts, int * microseconds)
+{
+    long long const usPerDay = 86400LL * 1000000;
+
+    long long days = ts.value / usPerDay;
+    long long us = ts.value % usPerDay;
+    if (us < 0)
+    {
+        --days;
+        us += usPerDay;
+    }
+
+    if (microseconds != NULL)
+    {
+        *microseconds = static_cast<int>(us % 1000000);
+    }
+
+    std::tm t = std::tm();
+    details::tm_from_ymdhms(t, 1970, 1, 1 + static_cast<int>(days),
+        0, 0, static_cast<int>(us / 1000000));
+
+    return t;
 }
@@ -93,34 +93,14 @@ void statement_impl::bind(values & values)
             else
             {
                 // named use element - check if it is used
-                std::string const placeholder = ":" + useName;
-
-                std::size_t pos = query_.find(placeholder);
-                while (pos != std::string::npos)
+                if (has_placeholder(useName))
                 {
-                    // Retrieve next char after placeholder
-                    // make sure we do not go out of range on the string
-                    const char nextChar = (pos + placeholder.size()) < query_.size() ?
-                                          query_[pos + placeholder.size()] : '\0';
-
-                    if (std::isalnum(nextChar))
-                    {
-                        // We got a partial match only,
-                        // keep looking for the placeholder
-                        pos = query_.find(placeholder, pos + placeholder.size());
-                    }
-                    else
-                    {
-                        int position = static_cast<int>(uses_.size());
-                        (*it)->bind(*this, position);
-                        uses_.push_back(*it);
-                        indicators_.push_back(values.indicators_[cnt]);
-                        // Ok we found it, done
-                        break;
-                    }
+                    int position = static_cast<int>(uses_.size());
+                    (*it)->bind(*this, position);
+                    uses_.push_back(*it);
+                    indicators_.push_back(values.indicators_[cnt]);
                 }
-                // In case we couldn't find the placeholder
-                if (pos == std::string::npos)
+                else
                 {
                     values.add_unused(*it, values.indicators_[cnt]);
                 }
@@ -140,6 +120,31 @@ void statement_impl::bind(values & values)
     }
 }
 
+bool statement_impl::has_placeholder(std::string const & name) const
+{
+    std::string const placeholder = ":" + name;
+
+    std::size_t pos = query_.find(placeholder);
+    while (pos != std::string::npos)
+    {
+        // Retrieve next char after placeholder
+        // make sure we do not go out of range on the string
+        const char nextChar = (pos + placeholder.size()) < query_.size() ?
+                              query_[pos + placeholder.size()] : '\0';
+
+        if (std::isalnum(nextChar) == 0)
+        {
+            return true;
+        }
+
+        // We got a partial match only,
+        // keep looking for the placeholder
+        pos = query_.find(placeholder, pos + placeholder.size());
+    }
+
+    return false;
+}
+
 void statement_impl::bind_clean_up()
 {
     // deallocate all bind and define objects
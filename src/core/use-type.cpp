@@ -10,6 +10,7 @@
 #include "soci/use-type.h"
 #include "soci/statement.h"
 #include "soci-exchange-cast.h"
+#include "soci-mktime.h"
 
 #include <cstdio>
 
@@ -109,6 +110,25 @@ void standard_use_type::dump_value(std::ostream& os) const
         case x_longstring:
             os << "<long string>";
             return;
+
+        case x_timestamp:
+            {
+                char buf[80];
+                format_timestamp(buf, sizeof(buf),
+                    exchange_type_cast<x_timestamp>(data_).value);
+
+                os << buf;
+            }
+            return;
+
+        case x_stringref:
+            {
+                string_ref const& r = exchange_type_cast<x_stringref>(data_);
+                os << "\"";
+                os.write(r.data, r.size);
+                os << "\"";
+            }
+            return;
     }
 
     // This is normally unreachable, but avoid throwing from here as we're
@@ -8,11 +8,15 @@
 #define SOCI_SOURCE
 #include "soci/values.h"
 #include "soci/row.h"
+#include "soci/session.h"
+#include "soci/values-exchange.h"
 
 #include <cstddef>
+#include <ctime>
 #include <map>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using namespace soci;
 using namespace soci::details;
@@ -67,3 +71,508 @@ column_properties const& values::get_properties(std::string const& name) const
 
     throw soci_error("Rowset is empty");
 }
+
+namespace soci
+{
+
+namespace details
+{
+
+// Columns of the bulk ORM elements: each of them owns the vector (and the
+// indicators) bound to one column or parameter of the statement.
+
+class values_into_column
+{
+public:
+    values_into_column() : into_(NULL) {}
+    virtual ~values_into_column() { delete into_; }
+
+    virtual void resize(std::size_t sz) = 0;
+
+    // add the holder of the column value to the row and set it to the value
+    // fetched for the given row
+    virtual void add_to_row(row & r) = 0;
+    virtual void set_row(std::size_t i) = 0;
+
+    into_type_base * into_;
+
+private:
+    SOCI_NOT_COPYABLE(values_into_column)
+};
+
+class values_use_column
+{
+public:
+    explicit values_use_column(std::size_t index) : use_(NULL), index_(index) {}
+    virtual ~values_use_column() { delete use_; }
+
+    virtual void resize(std::size_t sz) = 0;
+    virtual void set(std::size_t i, standard_use_type & u, indicator ind) = 0;
+
+    // check that the field of a row has the same type and name as the one
+    // the column was created for
+    virtual bool matches(standard_use_type & u) const = 0;
+
+    use_type_base * use_;
+    std::size_t const index_;
+
+private:
+    SOCI_NOT_COPYABLE(values_use_column)
+};
+
+} // namespace details
+
+} // namespace soci
+
+namespace // anonymous
+{
+
+template <typename T>
+class values_into_column_impl : public values_into_column
+{
+public:
+    explicit values_into_column_impl(std::size_t sz)
+        : data_(sz), ind_(sz), value_(NULL), valueInd_(NULL)
+    {
+        into_ = new into_type<std::vector<T> >(data_, ind_);
+    }
+
+    void resize(std::size_t sz) SOCI_OVERRIDE
+    {
+        data_.resize(sz);
+        ind_.resize(sz);
+    }
+
+    void add_to_row(row & r) SOCI_OVERRIDE
+    {
+        // the row takes ownership of both pointers
+        value_ = new T();
+        valueInd_ = new indicator(i_ok);
+        r.add_holder(value_, valueInd_);
+    }
+
+    void set_row(std::size_t i) SOCI_OVERRIDE
+    {
+        *value_ = data_[i];
+        *valueInd_ = ind_[i];
+    }
+
+private:
+    std::vector<T> data_;
+    std::vector<indicator> ind_;
+    T * value_;
+    indicator * valueInd_;
+};
+
+template <typename T>
+class values_use_column_impl : public values_use_column
+{
+public:
+    values_use_column_impl(std::size_t index, std::string const & name)
+        : values_use_column(index), name_(name)
+    {
+        use_ = new use_type<std::vector<T> >(data_, ind_, name);
+    }
+
+    void resize(std::size_t sz) SOCI_OVERRIDE
+    {
+        data_.resize(sz);
+        ind_.resize(sz);
+    }
+
+    void set(std::size_t i, standard_use_type & u, indicator ind) SOCI_OVERRIDE
+    {
+        data_[i] = *static_cast<T *>(u.get_data());
+        ind_[i] = ind;
+    }
+
+    bool matches(standard_use_type & u) const SOCI_OVERRIDE
+    {
+        return dynamic_cast<use_type<T> *>(&u) != NULL
+            && u.get_name() == name_;
+    }
+
+private:
+    std::string const name_;
+    std::vector<T> data_;
+    std::vector<indicator> ind_;
+};
+
+template <typename T>
+bool is_use_of(standard_use_type * u)
+{
+    return dynamic_cast<use_type<T> *>(u) != NULL;
+}
+
+values_use_column * make_use_column(standard_use_type * u, std::size_t index)
+{
+    std::string const name = u->get_name();
+
+    if (is_use_of<std::string>(u))
+        return new values_use_column_impl<std::string>(index, name);
+    if (is_use_of<double>(u))
+        return new values_use_column_impl<double>(index, name);
+    if (is_use_of<int>(u))
+        return new values_use_column_impl<int>(index, name);
+    if (is_use_of<long long>(u))
+        return new values_use_column_impl<long long>(index, name);
+    if (is_use_of<unsigned long long>(u))
+        return new values_use_column_impl<unsigned long long>(index, name);
+    if (is_use_of<std::tm>(u))
+        return new values_use_column_impl<std::tm>(index, name);
+    if (is_use_of<short>(u))
+        return new values_use_column_impl<short>(index, name);
+    if (is_use_of<char>(u))
+        return new values_use_column_impl<char>(index, name);
+
+    std::ostringstream msg;
+    msg << "type of value \"" << name
+        << "\" not supported for bulk operations with values";
+    throw soci_error(msg.str());
+}
+
+} // namespace anonymous
+
+into_type<std::vector<values> >::into_type(std::vector<values> & v,
+    std::vector<indicator> & ind, std::size_t /* begin */, std::size_t * end)
+    : v_(v), ind_(ind), st_(NULL), position_(1)
+{
+    if (end != NULL)
+    {
+        throw soci_error("Vector ranges are not supported with values.");
+    }
+}
+
+into_type<std::vector<values> >::~into_type()
+{
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        delete columns_[i];
+    }
+}
+
+void into_type<std::vector<values> >::define(statement_impl & st, int & position)
+{
+    // the columns are defined only once the statement is described,
+    // which happens as part of its execution
+    st_ = &st;
+    position_ = position;
+}
+
+void into_type<std::vector<values> >::describe()
+{
+    if (columns_.empty() == false)
+    {
+        return;
+    }
+
+    statement_backend * const backEnd = st_->get_backend();
+    std::size_t const sz = v_.size();
+
+    // the same row is reused for converting all the fetched rows
+    current_.reset();
+    current_.uppercase_column_names(
+        st_->session_.get_uppercase_column_names());
+    row & r = current_.get_row();
+
+    int const numcols = backEnd->prepare_for_describe();
+    for (int i = 1; i <= numcols; ++i)
+    {
+        data_type dtype;
+        std::string columnName;
+
+        backEnd->describe_column(i, dtype, columnName);
+
+        column_properties props;
+        props.set_name(columnName);
+        props.set_data_type(dtype);
+
+        values_into_column * column = NULL;
+        switch (dtype)
+        {
+        case dt_string:
+            column = new values_into_column_impl<std::string>(sz);
+            break;
+        case dt_double:
+            column = new values_into_column_impl<double>(sz);
+            break;
+        case dt_integer:
+            column = new values_into_column_impl<int>(sz);
+            break;
+        case dt_long_long:
+            column = new values_into_column_impl<long long>(sz);
+            break;
+        case dt_unsigned_long_long:
+            column = new values_into_column_impl<unsigned long long>(sz);
+            break;
+        case dt_date:
+            column = new values_into_column_impl<std::tm>(sz);
+            break;
+        default:
+            std::ostringstream msg;
+            msg << "db column type " << dtype
+                << " not supported for bulk selects into values";
+            throw soci_error(msg.str());
+        }
+
+        columns_.push_back(column);
+
+        r.add_properties(props);
+        column->add_to_row(r);
+    }
+
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->into_->define(*st_, position_);
+    }
+}
+
+void into_type<std::vector<values> >::pre_exec(int num)
+{
+    describe();
+
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->into_->pre_exec(num);
+    }
+}
+
+void into_type<std::vector<values> >::pre_fetch()
+{
+    describe();
+
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->into_->pre_fetch();
+    }
+}
+
+void into_type<std::vector<values> >::post_fetch(bool gotData, bool calledFromFetch)
+{
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->into_->post_fetch(gotData, calledFromFetch);
+    }
+
+    if (gotData == false)
+    {
+        return;
+    }
+
+    std::size_t const sz = v_.size();
+    ind_.resize(sz);
+    for (std::size_t i = 0; i != sz; ++i)
+    {
+        for (std::size_t c = 0; c != columns_.size(); ++c)
+        {
+            columns_[c]->set_row(i);
+        }
+
+        current_.reset_get_counter();
+
+        ind_[i] = i_ok;
+        convert_row_from_base(current_, i);
+    }
+}
+
+void into_type<std::vector<values> >::clean_up()
+{
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->into_->clean_up();
+        delete columns_[i];
+    }
+
+    columns_.clear();
+    current_.reset();
+}
+
+std::size_t into_type<std::vector<values> >::size() const
+{
+    // the user might have resized the vector since the last fetch
+    std::size_t const sz = v_.size();
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->resize(sz);
+    }
+
+    return sz;
+}
+
+void into_type<std::vector<values> >::resize(std::size_t sz)
+{
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->into_->resize(sz);
+    }
+
+    v_.resize(sz);
+    ind_.resize(sz);
+}
+
+use_type<std::vector<values> >::use_type(std::vector<values> & v,
+    std::vector<indicator> & /* ind */, std::size_t /* begin */,
+    std::size_t * end, std::string const & /* name */)
+    : v_(v), rows_(0)
+{
+    if (end != NULL)
+    {
+        throw soci_error("Vector ranges are not supported with values.");
+    }
+}
+
+use_type<std::vector<values> >::~use_type()
+{
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        delete columns_[i];
+    }
+
+    release_values();
+}
+
+void use_type<std::vector<values> >::bind(statement_impl & st, int & position)
+{
+    release_values();
+    convert_to_base();
+
+    if (v_.empty())
+    {
+        throw soci_error("Vectors of size 0 are not allowed.");
+    }
+
+    // the layout of the parameters is given by the first row, the named
+    // ones not referenced by the query are skipped as for single values
+    values const & first = v_[0];
+    for (std::size_t i = 0; i != first.uses_.size(); ++i)
+    {
+        std::string const name = first.uses_[i]->get_name();
+        if (name.empty() == false && st.has_placeholder(name) == false)
+        {
+            continue;
+        }
+
+        columns_.push_back(make_use_column(first.uses_[i], i));
+    }
+
+    gather();
+
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->use_->bind(st, position);
+    }
+}
+
+std::string use_type<std::vector<values> >::get_name() const
+{
+    std::ostringstream oss;
+
+    oss << "(";
+
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        if (i != 0)
+            oss << ", ";
+
+        oss << columns_[i]->use_->get_name();
+    }
+
+    oss << ")";
+
+    return oss.str();
+}
+
+void use_type<std::vector<values> >::dump_value(std::ostream& os) const
+{
+    os << "<vector>";
+}
+
+void use_type<std::vector<values> >::pre_exec(int num)
+{
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->use_->pre_exec(num);
+    }
+}
+
+void use_type<std::vector<values> >::pre_use()
+{
+    release_values();
+    convert_to_base();
+    gather();
+
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->use_->pre_use();
+    }
+}
+
+void use_type<std::vector<values> >::post_use(bool gotData)
+{
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->use_->post_use(gotData);
+    }
+}
+
+void use_type<std::vector<values> >::clean_up()
+{
+    for (std::size_t i = 0; i != columns_.size(); ++i)
+    {
+        columns_[i]->use_->clean_up();
+        delete columns_[i];
+    }
+
+    columns_.clear();
+    release_values();
+}
+
+std::size_t use_type<std::vector<values> >::size() const
+{
+    return rows_;
+}
+
+void use_type<std::vector<values> >::gather()
+{
+    rows_ = v_.size();
+
+    for (std::size_t c = 0; c != columns_.size(); ++c)
+    {
+        columns_[c]->resize(rows_);
+    }
+
+    std::size_t const numFields = rows_ != 0 ? v_[0].uses_.size() : 0;
+    for (std::size_t i = 0; i != rows_; ++i)
+    {
+        values & val = v_[i];
+        if (val.uses_.size() != numFields)
+        {
+            throw soci_error(
+                "All values used in bulk operations must have the same fields.");
+        }
+
+        for (std::size_t c = 0; c != columns_.size(); ++c)
+        {
+            std::size_t const index = columns_[c]->index_;
+            standard_use_type & u = *val.uses_[index];
+            if (columns_[c]->matches(u) == false)
+            {
+                throw soci_error("All values used in bulk operations must "
+                    "have the same fields of the same types.");
+            }
+
+            columns_[c]->set(i, u, *val.indicators_[index]);
+        }
+    }
+
+    // the parameters are bound using the columns only
+    release_values();
+}
+
+void use_type<std::vector<values> >::release_values()
+{
+    for (std::size_t i = 0; i != v_.size(); ++i)
+    {
+        v_[i].reset();
+    }
+}
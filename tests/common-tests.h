@@ -111,6 +111,15 @@ public:
     std::string phone_;
 };
 
+// Object whose phone is sometimes converted to a number, used to check that
+// all the rows of bulk ORM operations have the same fields
+struct PhonebookEntry4 : public PhonebookEntry
+{
+    PhonebookEntry4() : numericPhone(false) {}
+
+    bool numericPhone;
+};
+
 // user-defined object for test26 and test28
 class MyInt
 {
@@ -208,6 +217,31 @@ template<> struct type_conversion<PhonebookEntry3>
     }
 };
 
+template<> struct type_conversion<PhonebookEntry4>
+{
+    typedef soci::values base_type;
+
+    static void from_base(values const &v, indicator /* ind */, PhonebookEntry4 &pe)
+    {
+        pe.name = v.get<std::string>("NAME");
+        pe.phone = v.get<std::string>("PHONE", "<NULL>");
+    }
+
+    static void to_base(PhonebookEntry4 const &pe, values &v, indicator &ind)
+    {
+        v.set("NAME", pe.name);
+        if (pe.numericPhone)
+        {
+            v.set("PHONE", std::atoi(pe.phone.c_str()));
+        }
+        else
+        {
+            v.set("PHONE", pe.phone);
+        }
+        ind = i_ok;
+    }
+};
+
 } // namespace soci
 
 namespace soci
@@ -816,6 +850,73 @@ TEST_CASE_METHOD(common_tests, "Use vector", "[core][use][vector]")
     }
 }
 
+// bulk ORM: vectors of user types converted through values
+TEST_CASE_METHOD(common_tests, "Bulk ORM", "[core][orm][vector]")
+{
+    soci::session sql(backEndFactory_, connectString_);
+    sql.uppercase_column_names(true);
+
+    auto_table_creator tableCreator(tc_.table_creator_3(sql));
+
+    std::vector<PhonebookEntry> in(3);
+    in[0].name = "david";
+    in[0].phone = "(404) 123-4567";
+    in[1].name = "john";
+    in[1].phone = "(404) 456-7890";
+    in[2].name = "doe";
+    sql << "insert into soci_test(name, phone) values(:NAME, :PHONE)",
+        use(in);
+
+    int count = 0;
+    sql << "select count(*) from soci_test where phone is null", into(count);
+    CHECK(count == 1);
+
+    // fields not referenced by the query are not bound
+    std::vector<PhonebookEntry> upd(1);
+    upd[0].name = "david";
+    upd[0].phone = "(404) 000-0000";
+    sql << "update soci_test set phone = :PHONE where name = 'david'",
+        use(upd);
+
+    std::vector<PhonebookEntry> out(2);
+    statement st = (sql.prepare <<
+        "select name, phone from soci_test order by name", into(out));
+    st.execute();
+
+    REQUIRE(st.fetch());
+    REQUIRE(out.size() == 2);
+    CHECK(out[0].name == "david");
+    CHECK(out[0].phone == "(404) 000-0000");
+    CHECK(out[1].name == "doe");
+    CHECK(out[1].phone == "<NULL>");
+
+    REQUIRE(st.fetch());
+    REQUIRE(out.size() == 1);
+    CHECK(out[0].name == "john");
+    CHECK(out[0].phone == "(404) 456-7890");
+
+    CHECK_FALSE(st.fetch());
+
+    // the first rows can also be fetched by the execution itself
+    out.resize(3);
+    statement st2 = (sql.prepare <<
+        "select name, phone from soci_test order by name", into(out));
+    REQUIRE(st2.execute(true));
+    REQUIRE(out.size() == 3);
+    CHECK(out[0].name == "david");
+    CHECK(out[2].name == "john");
+
+    // all the rows must have the same fields of the same types
+    std::vector<PhonebookEntry4> mixed(2);
+    mixed[0].name = "jack";
+    mixed[0].phone = "1111";
+    mixed[1].name = "jill";
+    mixed[1].phone = "2222";
+    mixed[1].numericPhone = true;
+    CHECK_THROWS_AS((sql << "insert into soci_test(name, phone) "
+        "values(:NAME, :PHONE)", use(mixed)), soci_error&);
+}
+
 } // namespace test_cases
 
 } // namespace tests
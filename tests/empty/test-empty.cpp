@@ -7,6 +7,8 @@
 
 #include "soci/soci.h"
 #include "soci/empty/soci-empty.h"
+#include "soci-cstrtod.h"
+#include "soci-mktime.h"
 
 // Normally the tests would include common-tests.h here, but we can't run any
 // of the tests registered there, so instead include CATCH header directly.
@@ -14,8 +16,11 @@
 #include <catch.hpp>
 
 #include <iostream>
+#include <limits>
 #include <string>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 
 using namespace soci;
@@ -142,6 +147,409 @@ TEST_CASE("Dummy test", "[empty]")
 }
 
 
+TEST_CASE("Values set and update", "[core][values]")
+{
+    values v;
+
+    std::string const doc(1000, 'x');
+    v.set("doc", doc);
+    v.set("n", 17);
+    CHECK(v.get<std::string>("doc") == doc);
+    CHECK(v.get<int>("n") == 17);
+
+    // updating the value reuses the existing storage
+    v.set("doc", std::string("short"));
+    CHECK(v.get<std::string>("doc") == "short");
+
+    v.set("n", 0, i_null);
+    CHECK(v.get_indicator("n") == i_null);
+    CHECK(v.get<int>("n", -1) == -1);
+}
+
+// The numeric conversion functions are used by all the backends exchanging
+// data in text form, test them here as they don't need any database.
+TEST_CASE("String to integer conversion", "[core][numeric]")
+{
+    using soci::details::cstring_to_integer;
+
+    int i = 0;
+    CHECK(cstring_to_integer("0", i));
+    CHECK(i == 0);
+    CHECK(cstring_to_integer("-17", i));
+    CHECK(i == -17);
+    CHECK(cstring_to_integer(" +42", i));
+    CHECK(i == 42);
+    CHECK(cstring_to_integer("2147483647", i));
+    CHECK(i == 2147483647);
+    CHECK(cstring_to_integer("-2147483648", i));
+    CHECK(i == (std::numeric_limits<int>::min)());
+
+    i = 7;
+    CHECK_FALSE(cstring_to_integer("2147483648", i));
+    CHECK_FALSE(cstring_to_integer("-2147483649", i));
+    CHECK_FALSE(cstring_to_integer("", i));
+    CHECK_FALSE(cstring_to_integer("-", i));
+    CHECK_FALSE(cstring_to_integer("12a", i));
+    CHECK_FALSE(cstring_to_integer("12 ", i));
+    CHECK_FALSE(cstring_to_integer("1.5", i));
+    CHECK(i == 7);
+
+    short sh = 0;
+    CHECK(cstring_to_integer("-32768", sh));
+    CHECK(sh == -32768);
+    CHECK_FALSE(cstring_to_integer("32768", sh));
+
+    long long ll = 0;
+    CHECK(cstring_to_integer("-9223372036854775808", ll));
+    CHECK(ll == (std::numeric_limits<long long>::min)());
+    CHECK(cstring_to_integer("9223372036854775807", ll));
+    CHECK(ll == (std::numeric_limits<long long>::max)());
+    CHECK_FALSE(cstring_to_integer("9223372036854775808", ll));
+
+    unsigned long long ull = 0;
+    CHECK(cstring_to_integer("18446744073709551615", ull));
+    CHECK(ull == (std::numeric_limits<unsigned long long>::max)());
+    CHECK_FALSE(cstring_to_integer("18446744073709551616", ull));
+    CHECK_FALSE(cstring_to_integer("-1", ull));
+}
+
+TEST_CASE("String to double conversion", "[core][numeric]")
+{
+    using soci::details::cstring_to_double;
+
+    // Compare the results with strtod() in the "C" locale bit by bit, as
+    // both must be correctly rounded (this also works for NaN and infinity,
+    // which are still parsed by strtod()).
+    char const* const numbers[] =
+    {
+        "0", "-0", "1", "-1", "0.1", "3.14159", "-2.5e-3", "1e22", "1e23",
+        "123456789012345678", "1234567890123456789012", "9007199254740993",
+        "4.9e-324", "2.2250738585072014e-308", "1.7976931348623157e308",
+        "0.30000000000000004", ".5", "5.", "1E+10", "  12.5", "+7.25",
+        "1e-400", "123.456e-5", "0.000000000000000000000000001",
+        "7.1e37", "NaN", "Infinity", "-inf"
+    };
+
+    for (std::size_t n = 0; n != sizeof(numbers) / sizeof(numbers[0]); ++n)
+    {
+        char const* const s = numbers[n];
+        INFO("number is \"" << s << "\"");
+
+        double const expected = std::strtod(s, NULL);
+        double const actual = cstring_to_double(s);
+        CHECK(std::memcmp(&actual, &expected, sizeof(double)) == 0);
+    }
+
+    CHECK_THROWS_AS(cstring_to_double(""), soci_error&);
+    CHECK_THROWS_AS(cstring_to_double("1,5"), soci_error&);
+    CHECK_THROWS_AS(cstring_to_double("1.5x"), soci_error&);
+    CHECK_THROWS_AS(cstring_to_double("1e"), soci_error&);
+    CHECK_THROWS_AS(cstring_to_double("."), soci_error&);
+}
+
+TEST_CASE("Date and time parsing and formatting", "[core][datetime]")
+{
+    using soci::details::parse_std_tm;
+    using soci::details::format_std_tm;
+
+    std::tm t;
+    int us = -1;
+    parse_std_tm("2017-04-04 12:34:56", t, us);
+    CHECK(t.tm_year == 117);
+    CHECK(t.tm_mon == 3);
+    CHECK(t.tm_mday == 4);
+    CHECK(t.tm_hour == 12);
+    CHECK(t.tm_min == 34);
+    CHECK(t.tm_sec == 56);
+    CHECK(t.tm_wday == 2);
+    CHECK(t.tm_yday == 93);
+    CHECK(us == 0);
+
+    parse_std_tm("2000-02-29T23:59:59.123456789+02", t, us);
+    CHECK(t.tm_mday == 29);
+    CHECK(t.tm_sec == 59);
+    CHECK(us == 123456);
+
+    parse_std_tm("1969-12-31", t);
+    CHECK(t.tm_year == 69);
+    CHECK(t.tm_hour == 0);
+    CHECK(t.tm_wday == 3);
+    CHECK(t.tm_yday == 364);
+
+    parse_std_tm("10:20:30.5", t, us);
+    CHECK(t.tm_year == 0);
+    CHECK(t.tm_mon == 0);
+    CHECK(t.tm_mday == 1);
+    CHECK(t.tm_hour == 10);
+    CHECK(us == 500000);
+
+    // non-standard formats are still accepted
+    parse_std_tm("2017-4-4 1:2:3", t);
+    CHECK(t.tm_mon == 3);
+    CHECK(t.tm_mday == 4);
+    CHECK(t.tm_hour == 1);
+    CHECK(t.tm_sec == 3);
+
+    // out of range values are normalized
+    parse_std_tm("2017-02-29 24:00:00", t);
+    CHECK(t.tm_mon == 2);
+    CHECK(t.tm_mday == 2);
+    CHECK(t.tm_hour == 0);
+
+    CHECK_THROWS_AS(parse_std_tm("infinity", t), soci_error&);
+    CHECK_THROWS_AS(parse_std_tm("2017-01-01 BC", t), soci_error&);
+
+    // compare with the C library for a wide range of dates
+    for (std::time_t n = -2000000000; n < 2000000000; n += 86400 * 13 + 3671)
+    {
+        std::tm const expected = *std::gmtime(&n);
+
+        char buf[32];
+        std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &expected);
+        INFO("date is " << buf);
+
+        char formatted[32];
+        CHECK(format_std_tm(formatted, sizeof(formatted), expected) == 19);
+        CHECK(std::strcmp(formatted, buf) == 0);
+
+        parse_std_tm(buf, t);
+        CHECK(t.tm_year == expected.tm_year);
+        CHECK(t.tm_mon == expected.tm_mon);
+        CHECK(t.tm_mday == expected.tm_mday);
+        CHECK(t.tm_hour == expected.tm_hour);
+        CHECK(t.tm_min == expected.tm_min);
+        CHECK(t.tm_sec == expected.tm_sec);
+        CHECK(t.tm_wday == expected.tm_wday);
+        CHECK(t.tm_yday == expected.tm_yday);
+    }
+
+    char buf[32];
+    parse_std_tm("0099-01-02 03:04:05", t);
+    CHECK(format_std_tm(buf, sizeof(buf), t, 123) == 26);
+    CHECK(std::strcmp(buf, "0099-01-02 03:04:05.000123") == 0);
+
+    // too small buffer is handled as by snprintf()
+    CHECK(format_std_tm(buf, 11, t) == 19);
+    CHECK(std::strcmp(buf, "0099-01-02") == 0);
+}
+
+TEST_CASE("Batch date and time parsing", "[core][datetime]")
+{
+    char const* const values[] =
+    {
+        "2017-04-04 12:34:56", "2017-04-04 23:59:59.25", "2017-04-04",
+        "2017-04-05 00:00:01", "2017-04-05 24:00:00", "2017-04-05 1:2:3",
+        "2017-04-05T10:00:00", "12:00:00", "2017-04-05 10:00:00"
+    };
+
+    soci::details::std_tm_parser parser;
+    for (std::size_t n = 0; n != sizeof(values) / sizeof(values[0]); ++n)
+    {
+        INFO("date is " << values[n]);
+
+        std::tm expected, actual;
+        int expectedUs = -1, actualUs = -2;
+        soci::details::parse_std_tm(values[n], expected, expectedUs);
+        parser.parse(values[n], actual, actualUs);
+
+        CHECK(actual.tm_year == expected.tm_year);
+        CHECK(actual.tm_mon == expected.tm_mon);
+        CHECK(actual.tm_mday == expected.tm_mday);
+        CHECK(actual.tm_hour == expected.tm_hour);
+        CHECK(actual.tm_min == expected.tm_min);
+        CHECK(actual.tm_sec == expected.tm_sec);
+        CHECK(actual.tm_wday == expected.tm_wday);
+        CHECK(actual.tm_yday == expected.tm_yday);
+        CHECK(actualUs == expectedUs);
+    }
+}
+
+TEST_CASE("Timestamp conversions", "[core][datetime]")
+{
+    using soci::details::format_timestamp;
+    using soci::details::parse_timestamp;
+
+    CHECK(parse_timestamp("1970-01-01 00:00:00") == 0);
+    CHECK(parse_timestamp("2017-04-04 12:00:00") == 1491307200000000LL);
+    CHECK(parse_timestamp("2017-04-04 12:00:00.25") == 1491307200250000LL);
+    CHECK(parse_timestamp("1969-12-31 23:59:59.999999") == -1);
+    CHECK(parse_timestamp("2017-04-04") == 1491264000000000LL);
+
+    char buf[32];
+    CHECK(format_timestamp(buf, sizeof(buf), 1491307200250000LL) == 26);
+    CHECK(std::strcmp(buf, "2017-04-04 12:00:00.250000") == 0);
+
+    CHECK(format_timestamp(buf, sizeof(buf), -1) == 26);
+    CHECK(std::strcmp(buf, "1969-12-31 23:59:59.999999") == 0);
+
+    CHECK(format_timestamp(buf, sizeof(buf), 0) == 19);
+    CHECK(std::strcmp(buf, "1970-01-01 00:00:00") == 0);
+
+    std::tm t;
+    soci::details::parse_std_tm("2017-04-04 12:34:56", t);
+
+    timestamp const ts = timestamp_from_tm(t, 789);
+    CHECK(ts.value == parse_timestamp("2017-04-04 12:34:56.000789"));
+
+    int microseconds = 0;
+    std::tm const t2 = timestamp_to_tm(ts, &microseconds);
+    CHECK(t2.tm_year == t.tm_year);
+    CHECK(t2.tm_mon == t.tm_mon);
+    CHECK(t2.tm_mday == t.tm_mday);
+    CHECK(t2.tm_hour == t.tm_hour);
+    CHECK(t2.tm_min == t.tm_min);
+    CHECK(t2.tm_sec == t.tm_sec);
+    CHECK(t2.tm_wday == t.tm_wday);
+    CHECK(t2.tm_yday == t.tm_yday);
+    CHECK(microseconds == 789);
+}
+
+// This test is not run by default, use "[.benchmark]" to run it explicitly.
+TEST_CASE("Text conversion benchmark", "[.benchmark]")
+{
+    using soci::details::cstring_to_double;
+    using soci::details::cstring_to_integer;
+
+    // Typical values of integer and numeric(12, 2) columns.
+    int const count = 1000;
+    std::vector<std::string> integers, decimals;
+    for (int n = 0; n != count; ++n)
+    {
+        char buf[32];
+        std::sprintf(buf, "%d", n * 7919 - 1234567);
+        integers.push_back(buf);
+        std::sprintf(buf, "%d.%02d", n * 104729 % 10000000, n % 100);
+        decimals.push_back(buf);
+    }
+
+    int const iterations = 1000;
+
+    // Accumulate the results to prevent the calls from being optimized away.
+    long long sumOld = 0, sumNew = 0;
+    double dsumOld = 0, dsumNew = 0;
+
+    std::clock_t start = std::clock();
+    for (int it = 0; it != iterations; ++it)
+    {
+        for (int n = 0; n != count; ++n)
+        {
+            long long v = 0;
+            std::sscanf(integers[n].c_str(), "%lld", &v);
+            sumOld += v;
+        }
+    }
+    double const intOld = double(std::clock() - start) / CLOCKS_PER_SEC;
+
+    start = std::clock();
+    for (int it = 0; it != iterations; ++it)
+    {
+        for (int n = 0; n != count; ++n)
+        {
+            long long v = 0;
+            cstring_to_integer(integers[n].c_str(), v);
+            sumNew += v;
+        }
+    }
+    double const intNew = double(std::clock() - start) / CLOCKS_PER_SEC;
+
+    start = std::clock();
+    for (int it = 0; it != iterations; ++it)
+    {
+        for (int n = 0; n != count; ++n)
+        {
+            dsumOld += std::strtod(decimals[n].c_str(), NULL);
+        }
+    }
+    double const doubleOld = double(std::clock() - start) / CLOCKS_PER_SEC;
+
+    start = std::clock();
+    for (int it = 0; it != iterations; ++it)
+    {
+        for (int n = 0; n != count; ++n)
+        {
+            dsumNew += cstring_to_double(decimals[n].c_str());
+        }
+    }
+    double const doubleNew = double(std::clock() - start) / CLOCKS_PER_SEC;
+
+    // Timestamps, using the old approach with strtol() and mktime() as the
+    // reference.
+    std::vector<std::string> timestamps;
+    for (int n = 0; n != count; ++n)
+    {
+        std::time_t const tt = 1500000000 + n * 37;
+        char buf[32];
+        std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", std::gmtime(&tt));
+        timestamps.push_back(buf);
+    }
+
+    int const dateIterations = iterations / 10;
+    long long tsumOld = 0, tsumNew = 0, tsumBatch = 0;
+
+    start = std::clock();
+    for (int it = 0; it != dateIterations; ++it)
+    {
+        for (int n = 0; n != count; ++n)
+        {
+            char const* p = timestamps[n].c_str();
+            char* end;
+            int f[6];
+            for (int k = 0; k != 6; ++k)
+            {
+                f[k] = static_cast<int>(std::strtol(p, &end, 10));
+                p = end + 1;
+            }
+
+            std::tm t = std::tm();
+            soci::details::mktime_from_ymdhms(t,
+                f[0], f[1], f[2], f[3], f[4], f[5]);
+            tsumOld += t.tm_sec + t.tm_yday;
+        }
+    }
+    double const dateOld = double(std::clock() - start) / CLOCKS_PER_SEC;
+
+    start = std::clock();
+    for (int it = 0; it != dateIterations; ++it)
+    {
+        for (int n = 0; n != count; ++n)
+        {
+            std::tm t;
+            soci::details::parse_std_tm(timestamps[n].c_str(), t);
+            tsumNew += t.tm_sec + t.tm_yday;
+        }
+    }
+    double const dateNew = double(std::clock() - start) / CLOCKS_PER_SEC;
+
+    start = std::clock();
+    for (int it = 0; it != dateIterations; ++it)
+    {
+        soci::details::std_tm_parser parser;
+        for (int n = 0; n != count; ++n)
+        {
+            std::tm t;
+            parser.parse(timestamps[n].c_str(), t);
+            tsumBatch += t.tm_sec + t.tm_yday;
+        }
+    }
+    double const dateBatch = double(std::clock() - start) / CLOCKS_PER_SEC;
+
+    CHECK(sumOld == sumNew);
+    CHECK(std::memcmp(&dsumOld, &dsumNew, sizeof(double)) == 0);
+    CHECK(tsumOld == tsumNew);
+    CHECK(tsumOld == tsumBatch);
+
+    WARN("Parsing " << count * iterations << " integers: "
+         << intOld << "s with sscanf(), "
+         << intNew << "s with cstring_to_integer()");
+    WARN("Parsing " << count * iterations << " decimals: "
+         << doubleOld << "s with strtod(), "
+         << doubleNew << "s with cstring_to_double()");
+    WARN("Parsing " << count * dateIterations << " timestamps: "
+         << dateOld << "s with strtol() and mktime(), "
+         << dateNew << "s with parse_std_tm(), "
+         << dateBatch << "s with std_tm_parser");
+}
+
 int main(int argc, char** argv)
 {
 
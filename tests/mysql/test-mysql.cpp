@@ -12,6 +12,7 @@
 #include <string.h>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <cmath>
@@ -20,10 +21,903 @@
 #include <cstdlib>
 #include <mysqld_error.h>
 #include <errmsg.h>
+#ifdef SOCI_MYSQL_NONBLOCKING
+#include <poll.h>
+#endif
 
 std::string connectString;
 backend_factory const &backEnd = *soci::factory_mysql();
 
+// Server-side prepared statements
+
+struct table_creator_for_prepared : table_creator_base
+{
+    table_creator_for_prepared(soci::session & sql)
+        : table_creator_base(sql)
+    {
+        sql << "create table soci_test(id integer primary key, c char(1), "
+            "str varchar(20), sh smallint, i integer, ll bigint, "
+            "ull bigint unsigned, d double, tm datetime, ts datetime(6)) "
+            "engine=InnoDB";
+    }
+};
+
+mysql_statement_backend * get_mysql_backend(statement & st)
+{
+    return static_cast<mysql_statement_backend *>(st.get_backend());
+}
+
+std::tm make_tm(int year, int month, int day, int hour, int min, int sec)
+{
+    std::tm t = std::tm();
+    t.tm_year = year - 1900;
+    t.tm_mon = month - 1;
+    t.tm_mday = day;
+    t.tm_hour = hour;
+    t.tm_min = min;
+    t.tm_sec = sec;
+    return t;
+}
+
+void check_tm(std::tm const & t, int year, int month, int day,
+    int hour, int min, int sec)
+{
+    CHECK(t.tm_year == year - 1900);
+    CHECK(t.tm_mon == month - 1);
+    CHECK(t.tm_mday == day);
+    CHECK(t.tm_hour == hour);
+    CHECK(t.tm_min == min);
+    CHECK(t.tm_sec == sec);
+}
+
+TEST_CASE("MySQL prepared statements", "[mysql][prepared]")
+{
+    soci::session sql(backEnd, connectString + " statement_cache=4");
+    table_creator_for_prepared tableCreator(sql);
+
+    std::string const insertQuery("insert into soci_test"
+        "(id, c, str, sh, i, ll, ull, d, tm, ts) "
+        "values(:id, :c, :str, :sh, :i, :ll, :ull, :d, :tm, :ts)");
+    std::string const selectQuery("select c, str, sh, i, ll, ull, d, tm, ts "
+        "from soci_test where id = :id");
+
+    timestamp const ts = timestamp_from_tm(make_tm(2017, 1, 2, 3, 4, 5), 123456);
+
+    SECTION("single")
+    {
+        int id = 1;
+        char c = 'a';
+        std::string str("it's a \"test\"\\");
+        short sh = -12345;
+        int i = -2000000000;
+        long long ll = -9000000000000000000LL;
+        unsigned long long ull = 18000000000000000000ULL;
+        double d = 3.1415926;
+        std::tm tm = make_tm(2016, 12, 31, 23, 59, 58);
+        timestamp t = ts;
+        indicator ind = i_ok;
+
+        statement st = (sql.prepare << insertQuery, use(id, "id"),
+            use(c, ind, "c"), use(str, ind, "str"), use(sh, ind, "sh"),
+            use(i, ind, "i"), use(ll, ind, "ll"), use(ull, ind, "ull"),
+            use(d, ind, "d"), use(tm, ind, "tm"), use(t, ind, "ts"));
+        CHECK(get_mysql_backend(st)->stmt_ != NULL);
+
+        st.execute(true);
+        CHECK(st.get_affected_rows() == 1);
+
+        id = 2;
+        ind = i_null;
+        st.execute(true);
+        CHECK(st.get_affected_rows() == 1);
+
+        char c2 = '\0';
+        std::string str2;
+        short sh2 = 0;
+        int i2 = 0;
+        long long ll2 = 0;
+        unsigned long long ull2 = 0;
+        double d2 = 0;
+        std::tm tm2 = std::tm();
+        timestamp t2;
+        indicator inds[9];
+
+        statement sel = (sql.prepare << selectQuery, use(id, "id"),
+            into(c2, inds[0]), into(str2, inds[1]), into(sh2, inds[2]),
+            into(i2, inds[3]), into(ll2, inds[4]), into(ull2, inds[5]),
+            into(d2, inds[6]), into(tm2, inds[7]), into(t2, inds[8]));
+        CHECK(get_mysql_backend(sel)->stmt_ != NULL);
+
+        id = 1;
+        REQUIRE(sel.execute(true));
+        for (int n = 0; n != 9; ++n)
+        {
+            CHECK(inds[n] == i_ok);
+        }
+        CHECK(c2 == c);
+        CHECK(str2 == str);
+        CHECK(sh2 == sh);
+        CHECK(i2 == i);
+        CHECK(ll2 == ll);
+        CHECK(ull2 == ull);
+        CHECK(d2 == d);
+        check_tm(tm2, 2016, 12, 31, 23, 59, 58);
+        CHECK(t2.value == ts.value);
+
+        id = 2;
+        REQUIRE(sel.execute(true));
+        for (int n = 0; n != 9; ++n)
+        {
+            CHECK(inds[n] == i_null);
+        }
+
+        // positional parameters
+        str = "updated";
+        id = 1;
+        sql << "update soci_test set str = :str where id = :id",
+            use(str), use(id);
+        sql << "select str from soci_test where id = 1", into(str2);
+        CHECK(str2 == "updated");
+
+        statement upd = (sql.prepare <<
+            "update soci_test set d = :d where id > :id", use(d), use(id));
+        d = 2.5;
+        id = 0;
+        upd.execute(true);
+        CHECK(upd.get_affected_rows() == 2);
+    }
+
+    SECTION("bulk")
+    {
+        std::vector<int> id;
+        std::vector<char> c;
+        std::vector<std::string> str;
+        std::vector<short> sh;
+        std::vector<int> i;
+        std::vector<long long> ll;
+        std::vector<unsigned long long> ull;
+        std::vector<double> d;
+        std::vector<std::tm> tm;
+        std::vector<timestamp> t;
+        std::vector<indicator> ind;
+        for (int n = 0; n != 3; ++n)
+        {
+            id.push_back(n + 1);
+            c.push_back(static_cast<char>('a' + n));
+            str.push_back(std::string(n + 1, 'x'));
+            sh.push_back(static_cast<short>(-n));
+            i.push_back(n * 1000000);
+            ll.push_back(n * 10000000000LL);
+            ull.push_back(n * 10000000000ULL);
+            d.push_back(n + 0.5);
+            tm.push_back(make_tm(2016, 1, n + 1, 0, 0, n));
+            t.push_back(timestamp(ts.value + n));
+            ind.push_back(n == 1 ? i_null : i_ok);
+        }
+
+        statement st = (sql.prepare << insertQuery, use(id, "id"),
+            use(c, ind, "c"), use(str, ind, "str"), use(sh, ind, "sh"),
+            use(i, ind, "i"), use(ll, ind, "ll"), use(ull, ind, "ull"),
+            use(d, ind, "d"), use(tm, ind, "tm"), use(t, ind, "ts"));
+        CHECK(get_mysql_backend(st)->stmt_ != NULL);
+
+        st.execute(true);
+        CHECK(st.get_affected_rows() == 3);
+
+        std::vector<char> c2(10);
+        std::vector<std::string> str2(10);
+        std::vector<short> sh2(10);
+        std::vector<int> i2(10);
+        std::vector<long long> ll2(10);
+        std::vector<unsigned long long> ull2(10);
+        std::vector<double> d2(10);
+        std::vector<std::tm> tm2(10);
+        std::vector<timestamp> t2(10);
+        std::vector<std::vector<indicator> > ind2(9);
+
+        sql << "select c, str, sh, i, ll, ull, d, tm, ts "
+            "from soci_test order by id",
+            into(c2, ind2[0]), into(str2, ind2[1]), into(sh2, ind2[2]),
+            into(i2, ind2[3]), into(ll2, ind2[4]), into(ull2, ind2[5]),
+            into(d2, ind2[6]), into(tm2, ind2[7]), into(t2, ind2[8]);
+        REQUIRE(c2.size() == 3);
+        for (int n = 0; n != 3; ++n)
+        {
+            for (int col = 0; col != 9; ++col)
+            {
+                CHECK(ind2[col][n] == ind[n]);
+            }
+
+            if (ind[n] == i_null)
+            {
+                continue;
+            }
+
+            CHECK(c2[n] == c[n]);
+            CHECK(str2[n] == str[n]);
+            CHECK(sh2[n] == sh[n]);
+            CHECK(i2[n] == i[n]);
+            CHECK(ll2[n] == ll[n]);
+            CHECK(ull2[n] == ull[n]);
+            CHECK(d2[n] == d[n]);
+            check_tm(tm2[n], 2016, 1, n + 1, 0, 0, n);
+            CHECK(t2[n].value == t[n].value);
+        }
+
+        std::vector<int> ids;
+        ids.push_back(1);
+        ids.push_back(3);
+        ids.push_back(4);
+        std::vector<std::string> strs(3, "updated");
+        statement upd = (sql.prepare <<
+            "update soci_test set str = :str where id = :id",
+            use(strs, "str"), use(ids, "id"));
+        upd.execute(true);
+        CHECK(upd.get_affected_rows() == 2);
+
+        int count = 0;
+        sql << "select count(*) from soci_test where str = 'updated'",
+            into(count);
+        CHECK(count == 2);
+    }
+
+    SECTION("binary results")
+    {
+        sql << "insert into soci_test(id, str, sh, i, ll, ull, d, tm, ts) "
+            "values(1, 'abc', -7, 42, 5000000000, 18000000000000000000, "
+            "2.5, '2016-12-31 23:59:58', '2017-01-02 03:04:05.123456')";
+
+        std::string str;
+        short sh = 0;
+        int i = 0;
+        long long ll = 0;
+        unsigned long long ull = 0;
+        double d = 0;
+        std::tm tm = std::tm();
+        timestamp t;
+
+        statement sel = (sql.prepare <<
+            "select str, sh, i, ll, ull, d, tm, ts from soci_test",
+            into(str), into(sh), into(i), into(ll), into(ull), into(d),
+            into(tm), into(t));
+        REQUIRE(sel.execute(true));
+
+        // Only the strings are retrieved as text.
+        std::vector<MYSQL_BIND> const & binds
+            = get_mysql_backend(sel)->resultBinds_;
+        REQUIRE(binds.size() == 8);
+        CHECK(binds[0].buffer_type == MYSQL_TYPE_STRING);
+        CHECK(binds[1].buffer_type == MYSQL_TYPE_LONG);
+        CHECK(binds[2].buffer_type == MYSQL_TYPE_LONG);
+        CHECK(binds[3].buffer_type == MYSQL_TYPE_LONGLONG);
+        CHECK(binds[4].buffer_type == MYSQL_TYPE_LONGLONG);
+        CHECK(binds[5].buffer_type == MYSQL_TYPE_DOUBLE);
+        CHECK(binds[6].buffer_type == MYSQL_TYPE_DATETIME);
+        CHECK(binds[7].buffer_type == MYSQL_TYPE_DATETIME);
+
+        CHECK(str == "abc");
+        CHECK(sh == -7);
+        CHECK(i == 42);
+        CHECK(ll == 5000000000LL);
+        CHECK(ull == 18000000000000000000ULL);
+        CHECK(d == 2.5);
+        check_tm(tm, 2016, 12, 31, 23, 59, 58);
+        CHECK(t.value == ts.value);
+
+        // The numbers fetched into strings are retrieved as text.
+        std::string s;
+        statement selStr = (sql.prepare << "select i from soci_test",
+            into(s));
+        REQUIRE(selStr.execute(true));
+        CHECK(get_mysql_backend(selStr)->resultBinds_[0].buffer_type
+                == MYSQL_TYPE_STRING);
+        CHECK(s == "42");
+
+        // The binary values are converted to the other numeric types if they
+        // fit into them.
+        sql << "select i, sh from soci_test", into(d), into(ll);
+        CHECK(d == 42);
+        CHECK(ll == -7);
+
+        sql << "update soci_test set d = 3";
+        sql << "select d from soci_test", into(i);
+        CHECK(i == 3);
+
+        sql << "update soci_test set d = 2.5";
+        CHECK_THROWS_AS((sql << "select d from soci_test", into(ll)),
+            soci_error&);
+        CHECK_THROWS_AS((sql << "select ll from soci_test", into(i)),
+            soci_error&);
+        CHECK_THROWS_AS((sql << "select ull from soci_test", into(ll)),
+            soci_error&);
+
+        // The rows use the types of the binary values too.
+        row r;
+        sql << "select sh, ull, d, tm from soci_test", into(r);
+        REQUIRE(r.size() == 4);
+        CHECK(r.get<int>(0) == -7);
+        CHECK(r.get<unsigned long long>(1) == 18000000000000000000ULL);
+        CHECK(r.get<double>(2) == 2.5);
+        check_tm(r.get<std::tm>(3), 2016, 12, 31, 23, 59, 58);
+    }
+
+    SECTION("cache")
+    {
+        MYSQL_STMT * first = NULL;
+        {
+            int id = 1;
+            statement st = (sql.prepare <<
+                "insert into soci_test(id) values(:id)", use(id));
+            first = get_mysql_backend(st)->stmt_;
+            REQUIRE(first != NULL);
+            st.execute(true);
+        }
+
+        // The statement is reused after being reset when it fails.
+        {
+            std::vector<int> ids;
+            ids.push_back(2);
+            ids.push_back(1);
+            ids.push_back(3);
+            statement st = (sql.prepare <<
+                "insert into soci_test(id) values(:id)", use(ids));
+            CHECK(get_mysql_backend(st)->stmt_ == first);
+            CHECK_THROWS_AS(st.execute(true), mysql_soci_error&);
+            CHECK(st.get_affected_rows() == 1);
+        }
+
+        {
+            int id = 4;
+            statement st = (sql.prepare <<
+                "insert into soci_test(id) values(:id)", use(id));
+            CHECK(get_mysql_backend(st)->stmt_ == first);
+            st.execute(true);
+            CHECK(st.get_affected_rows() == 1);
+        }
+
+        // A query whose rows were not all fetched is reusable too.
+        MYSQL_STMT * select = NULL;
+        {
+            int id = 0;
+            statement st = (sql.prepare <<
+                "select id from soci_test order by id", into(id));
+            select = get_mysql_backend(st)->stmt_;
+            REQUIRE(select != NULL);
+            REQUIRE(st.execute(true));
+            CHECK(id == 1);
+        }
+
+        std::vector<int> ids(10);
+        statement st = (sql.prepare <<
+            "select id from soci_test order by id", into(ids));
+        CHECK(get_mysql_backend(st)->stmt_ == select);
+        st.execute(true);
+        REQUIRE(ids.size() == 3);
+        CHECK(ids[0] == 1);
+        CHECK(ids[1] == 2);
+        CHECK(ids[2] == 4);
+    }
+
+    SECTION("long values")
+    {
+        sql << "create temporary table soci_long_test"
+            "(id integer auto_increment primary key, t text)";
+
+        std::string const big(100000, 'x');
+        std::vector<std::string> in;
+        in.push_back("short");
+        in.push_back(big);
+        in.push_back("short again");
+        sql << "insert into soci_long_test(t) values(:t)", use(in);
+
+        // The values longer than the initial buffer are fetched again.
+        std::vector<std::string> out(3);
+        statement st = (sql.prepare <<
+            "select t from soci_long_test order by id", into(out));
+        CHECK(get_mysql_backend(st)->stmt_ != NULL);
+        st.execute(true);
+        REQUIRE(out.size() == 3);
+        CHECK(out[0] == in[0]);
+        CHECK(out[1] == big);
+        CHECK(out[2] == in[2]);
+
+        sql << "drop temporary table soci_long_test";
+    }
+}
+
+// Multi-row INSERT batching
+
+std::string::size_type get_insert_values_pos(soci::session & sql,
+    std::string const & query)
+{
+    int id = 0;
+    std::string str;
+    statement st = (sql.prepare << query, use(id, "id"), use(str, "str"));
+    return get_mysql_backend(st)->insertValuesPos_;
+}
+
+TEST_CASE("MySQL batched insert detection", "[mysql][bulk][batch]")
+{
+    soci::session sql(backEnd, connectString);
+
+    std::string::size_type const npos = std::string::npos;
+
+    CHECK(get_insert_values_pos(sql,
+        "insert into soci_test(id, str) values(:id, :str)") == 37);
+    CHECK(get_insert_values_pos(sql,
+        "  Replace Into soci_test(id, str) VALUES (:id, :str)  ") == 41);
+
+    // parentheses and keywords in quotes are ignored
+    CHECK(get_insert_values_pos(sql,
+        "insert into `values`(id, str) values(:id, concat(:str, ')'))")
+        == 36);
+    CHECK(get_insert_values_pos(sql,
+        "insert into soci_test(id, str) values(:id, 'it\\'s a ) values(')")
+        == 37);
+    CHECK(get_insert_values_pos(sql,
+        "insert into soci_test(id, str) select :id, 'values(:str)'") == npos);
+
+    // nothing can follow the row of values
+    CHECK(get_insert_values_pos(sql,
+        "insert into soci_test(id, str) values(:id, :str);") == npos);
+    CHECK(get_insert_values_pos(sql,
+        "insert into soci_test(id, str) values(:id, :str) "
+        "on duplicate key update str = values(str)") == npos);
+
+    // no parameters may precede the values
+    CHECK(get_insert_values_pos(sql,
+        "insert into soci_test(id, str) select :id, :str union values(1, 2)")
+        == npos);
+
+    CHECK(get_insert_values_pos(sql,
+        "update soci_test set str = :str where id = :id") == npos);
+}
+
+struct table_creator_for_batch : table_creator_base
+{
+    table_creator_for_batch(soci::session & sql, std::string const & engine)
+        : table_creator_base(sql)
+    {
+        sql << "create table soci_test(id integer primary key, "
+            "str varchar(20)) engine=" + engine;
+    }
+};
+
+TEST_CASE("MySQL batched insert", "[mysql][bulk][batch]")
+{
+    soci::session sql(backEnd, connectString + " batch_insert=1");
+    table_creator_for_batch tableCreator(sql, "InnoDB");
+
+    std::vector<int> ids;
+    std::vector<std::string> strs;
+    for (int i = 0; i != 100; ++i)
+    {
+        ids.push_back(i);
+        strs.push_back(std::string(i % 20, 'x'));
+    }
+
+    std::string const query(
+        "insert into soci_test(id, str) values(:id, :str)");
+
+    SECTION("split by max_allowed_packet")
+    {
+        // Pretend that the packets are small to have many batches.
+        static_cast<mysql_session_backend *>(sql.get_backend())
+            ->maxAllowedPacket_ = 200;
+
+        statement st = (sql.prepare << query, use(ids), use(strs));
+        st.execute(true);
+        CHECK(st.get_affected_rows() == 100);
+
+        std::vector<int> ids2(200);
+        std::vector<std::string> strs2(200);
+        sql << "select id, str from soci_test order by id",
+            into(ids2), into(strs2);
+        REQUIRE(ids2.size() == 100);
+        CHECK(ids2 == ids);
+        CHECK(strs2 == strs);
+    }
+
+    SECTION("failing row")
+    {
+        ids[50] = 10;
+
+        statement st = (sql.prepare << query, use(ids), use(strs));
+        CHECK_THROWS_AS(st.execute(true), mysql_soci_error&);
+        CHECK(st.get_affected_rows() == 50);
+
+        int count = 0;
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == 50);
+    }
+
+    SECTION("non-data error")
+    {
+        // Errors not caused by the row values are not retried row by row,
+        // so nothing is inserted as the whole statement fails.
+        sql << "create trigger soci_test_trigger before insert on soci_test "
+            "for each row begin if new.id = 50 then signal sqlstate '45000' "
+            "set message_text = 'row 50'; end if; end";
+
+        statement st = (sql.prepare << query, use(ids), use(strs));
+        CHECK_THROWS_AS(st.execute(true), mysql_soci_error&);
+        CHECK(st.get_affected_rows() <= 0);
+
+        int count = -1;
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == 0);
+
+        sql << "drop trigger soci_test_trigger";
+    }
+}
+
+TEST_CASE("MySQL insert without batching", "[mysql][bulk][batch]")
+{
+    // Batching is disabled by default.
+    soci::session sql(backEnd, connectString);
+    table_creator_for_batch tableCreator(sql, "MyISAM");
+
+    std::vector<int> ids;
+    for (int i = 0; i != 10; ++i)
+    {
+        ids.push_back(i);
+    }
+    ids[5] = 1;
+
+    statement st = (sql.prepare <<
+        "insert into soci_test(id) values(:id)", use(ids));
+    CHECK_THROWS_AS(st.execute(true), mysql_soci_error&);
+    CHECK(st.get_affected_rows() == 5);
+
+    int count = 0;
+    sql << "select count(*) from soci_test", into(count);
+    CHECK(count == 5);
+}
+
+// Streaming results with mysql_use_result()
+
+TEST_CASE("MySQL streaming results", "[mysql][use_result]")
+{
+    soci::session sql(backEnd, connectString + " use_result=1");
+    table_creator_for_prepared tableCreator(sql);
+
+    int const rows = 25;
+    for (int i = 0; i != rows; ++i)
+    {
+        std::ostringstream ss;
+        ss << "str" << i;
+        std::string const str = ss.str();
+        sql << "insert into soci_test(id, str) values(:id, :str)",
+            use(i), use(str);
+    }
+
+    SECTION("vector")
+    {
+        std::vector<int> ids(10);
+        std::vector<std::string> strs(10);
+        statement st = (sql.prepare <<
+            "select id, str from soci_test order by id",
+            into(ids), into(strs));
+        st.execute();
+
+        int count = 0;
+        while (st.fetch())
+        {
+            for (std::size_t i = 0; i != ids.size(); ++i, ++count)
+            {
+                std::ostringstream ss;
+                ss << "str" << count;
+                CHECK(ids[i] == count);
+                CHECK(strs[i] == ss.str());
+            }
+        }
+        CHECK(count == rows);
+
+        // The session can be used again once all the rows are fetched.
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == rows);
+    }
+
+    SECTION("string_ref")
+    {
+        std::vector<string_ref> refs(4);
+        statement st = (sql.prepare <<
+            "select str from soci_test where id < 5 order by id",
+            into(refs));
+        st.execute();
+
+        // Each batch must refer to its own rows and not to the first ones.
+        REQUIRE(st.fetch());
+        REQUIRE(refs.size() == 4);
+        CHECK(refs[0].str() == "str0");
+        CHECK(refs[3].str() == "str3");
+
+        REQUIRE(st.fetch());
+        REQUIRE(refs.size() == 1);
+        CHECK(refs[0].str() == "str4");
+
+        CHECK_FALSE(st.fetch());
+
+        string_ref r;
+        sql << "select str from soci_test where id = 7", into(r);
+        CHECK(r.str() == "str7");
+    }
+
+    SECTION("row")
+    {
+        row r;
+        statement st = (sql.prepare <<
+            "select id, str from soci_test order by id", into(r));
+        st.execute();
+
+        // Describing the row must not consume the first row of the result.
+        int count = 0;
+        while (st.fetch())
+        {
+            REQUIRE(r.size() == 2);
+            CHECK(r.get_properties(1).get_name() == "str");
+            CHECK(r.get<int>(0) == count);
+            ++count;
+        }
+        CHECK(count == rows);
+    }
+
+    SECTION("early destruction")
+    {
+        {
+            std::vector<int> ids(3);
+            statement st = (sql.prepare <<
+                "select id from soci_test order by id", into(ids));
+            st.execute();
+            REQUIRE(st.fetch());
+            CHECK(ids[2] == 2);
+        }
+
+        // The rest of the result has been discarded with the statement.
+        int count = 0;
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == rows);
+    }
+}
+
+// Loading data with LOAD DATA LOCAL INFILE
+
+struct load_data_test_row
+{
+    int id;
+    std::string str;
+    bool null;
+};
+
+mysql_load_data_row & operator<<(mysql_load_data_row & row,
+    load_data_test_row const & r)
+{
+    row << r.id;
+    if (r.null)
+        row.add_null();
+    else
+        row << r.str;
+    return row;
+}
+
+struct failing_load_data_source : mysql_load_data_source
+{
+    failing_load_data_source() : rows_(0), batches_(0) {}
+
+    bool next_row(mysql_load_data_row & row) SOCI_OVERRIDE
+    {
+        if (rows_ == 5)
+        {
+            throw std::runtime_error("source failure");
+        }
+
+        row << rows_++ << "x";
+        return true;
+    }
+
+    void on_batch(std::size_t rows, std::size_t /* bytes */,
+        double seconds) SOCI_OVERRIDE
+    {
+        CHECK(rows == 2);
+        CHECK(seconds >= 0);
+        ++batches_;
+    }
+
+    int rows_;
+    int batches_;
+};
+
+TEST_CASE("MySQL load data", "[mysql][load_data]")
+{
+    soci::session sql(backEnd, connectString + " local_infile=1");
+    table_creator_for_prepared tableCreator(sql);
+
+    mysql_session_backend * const backend =
+        static_cast<mysql_session_backend *>(sql.get_backend());
+
+    SECTION("escaping")
+    {
+        load_data_test_row const data[] =
+        {
+            { 1, "tab\there", false },
+            { 2, "new\nline", false },
+            { 3, "back\\slash\\N", false },
+            { 4, "", true },
+            { 5, "\\", false },
+        };
+        std::size_t const count = sizeof(data) / sizeof(data[0]);
+
+        CHECK(backend->load_data("soci_test", data, data + count, "id, str")
+            == static_cast<long long>(count));
+
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            std::string str;
+            indicator ind;
+            sql << "select str from soci_test where id = :id",
+                into(str, ind), use(data[i].id);
+            if (data[i].null)
+            {
+                CHECK(ind == i_null);
+            }
+            else
+            {
+                CHECK(ind == i_ok);
+                CHECK(str == data[i].str);
+            }
+        }
+    }
+
+    SECTION("source exception")
+    {
+        failing_load_data_source source;
+        CHECK_THROWS_AS(
+            backend->load_data("soci_test", source, "id, str", 2),
+            soci_error&);
+        CHECK(source.batches_ == 2);
+
+        // Nothing is loaded and the session remains usable after the failure.
+        int count = -1;
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == 0);
+    }
+
+    SECTION("names")
+    {
+        int const ids[] = { 1, 2 };
+
+        // Names are quoted, so they can't be used to inject SQL.
+        CHECK_THROWS_AS(
+            backend->load_data("soci_test (id); drop table soci_test; --",
+                ids, ids + 2),
+            mysql_soci_error&);
+        CHECK_THROWS_AS(backend->load_data("soci_test", ids, ids + 2, "id,"),
+            soci_error&);
+
+        CHECK(backend->load_data("test.soci_test", ids, ids + 2, " id ") == 2);
+    }
+}
+
+#ifdef SOCI_MYSQL_NONBLOCKING
+
+// Asynchronous queries
+
+// Wait for the events requested by the query using poll().
+int poll_async_query(mysql_async_query & q, int status)
+{
+    pollfd pfd;
+    pfd.fd = q.socket();
+    pfd.events = 0;
+    pfd.revents = 0;
+    if (status & MYSQL_WAIT_READ)
+        pfd.events |= POLLIN;
+    if (status & MYSQL_WAIT_WRITE)
+        pfd.events |= POLLOUT;
+    if (status & MYSQL_WAIT_EXCEPT)
+        pfd.events |= POLLPRI;
+
+    int const timeout = status & MYSQL_WAIT_TIMEOUT
+        ? static_cast<int>(q.timeout()) : -1;
+    int const res = poll(&pfd, 1, timeout);
+    REQUIRE(res >= 0);
+
+    int events = res == 0 ? MYSQL_WAIT_TIMEOUT : 0;
+    if (pfd.revents & POLLIN)
+        events |= MYSQL_WAIT_READ;
+    if (pfd.revents & POLLOUT)
+        events |= MYSQL_WAIT_WRITE;
+    if (pfd.revents & POLLPRI)
+        events |= MYSQL_WAIT_EXCEPT;
+    return events;
+}
+
+// Run the query until it completes or fetches the first row.
+void run_async_query(mysql_async_query & q)
+{
+    int status = q.start();
+    while (status != 0)
+    {
+        status = q.resume(poll_async_query(q, status));
+    }
+}
+
+TEST_CASE("MySQL asynchronous query", "[mysql][async]")
+{
+    soci::session sql(backEnd, connectString + " nonblocking=1");
+    table_creator_for_prepared tableCreator(sql);
+
+    mysql_session_backend & backend =
+        *static_cast<mysql_session_backend *>(sql.get_backend());
+
+    SECTION("update and select")
+    {
+        mysql_async_query ins(backend,
+            "insert into soci_test(id, str) values(1, 'one'), (2, NULL)");
+        run_async_query(ins);
+        CHECK(ins.done());
+        CHECK(ins.affected_rows() == 2);
+
+        mysql_async_query q(backend,
+            "select id, str from soci_test order by id");
+        std::vector<std::string> ids;
+        std::vector<bool> nulls;
+        int status = q.start();
+        while (!q.done())
+        {
+            if (status != 0)
+            {
+                status = q.resume(poll_async_query(q, status));
+            }
+            else
+            {
+                REQUIRE(q.has_row());
+                REQUIRE(q.columns() == 2);
+                ids.push_back(q.get(0));
+                nulls.push_back(q.is_null(1));
+                status = q.fetch_next();
+            }
+        }
+
+        REQUIRE(ids.size() == 2);
+        CHECK(ids[0] == "1");
+        CHECK(ids[1] == "2");
+        CHECK_FALSE(nulls[0]);
+        CHECK(nulls[1]);
+    }
+
+    SECTION("error")
+    {
+        mysql_async_query q(backend, "select * from soci_no_such_table");
+        CHECK_THROWS_AS(run_async_query(q), mysql_soci_error&);
+        CHECK(q.done());
+    }
+
+    SECTION("early destruction")
+    {
+        sql << "insert into soci_test(id) values(1), (2), (3)";
+
+        {
+            // Destroy the query while it is being executed.
+            mysql_async_query q(backend, "select id from soci_test");
+            q.start();
+        }
+
+        {
+            // And after fetching only the first row.
+            mysql_async_query q(backend, "select id from soci_test");
+            run_async_query(q);
+            CHECK(q.has_row());
+        }
+
+        // The session can be used again.
+        int count = 0;
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == 3);
+    }
+}
+
+#endif // SOCI_MYSQL_NONBLOCKING
+
 int main(int argc, char** argv)
 {
     connectString = "host=127.0.0.1 db=test user=root password=asdfgUIOPNjiJIgegiIGef charset=utf8mb4";
@@ -990,6 +990,363 @@ TEST_CASE("Bulk iterators", "[postgresql][bulkiters]")
     sql << "drop table t";
 }
 
+// Test the bulk operations in the single-row mode
+TEST_CASE("PostgreSQL single-row mode bulk fetch", "[postgresql][singlerow][vector]")
+{
+    soci::session sql(backEnd, connectString + " singlerows=true");
+
+    table_creator_for_test11 tableCreator(sql);
+
+    std::vector<int> ins;
+    for (int i = 0; i != 25; i++)
+    {
+        ins.push_back(i);
+    }
+    sql << "insert into soci_test(val) values(:val)", use(ins);
+
+    std::vector<int> v(10);
+    statement st = (sql.prepare <<
+        "select val from soci_test order by val", into(v));
+
+    std::vector<int> all;
+    st.execute();
+    while (st.fetch())
+    {
+        REQUIRE(v.size() <= 10);
+        all.insert(all.end(), v.begin(), v.end());
+
+        // use a smaller size for the next fetches to check that the rows
+        // already received from the server are not lost
+        v.resize(7);
+    }
+
+    REQUIRE(all.size() == 25);
+    for (int i = 0; i != 25; i++)
+    {
+        CHECK(all[i] == i);
+    }
+
+    // the session must be usable for the subsequent queries
+    int count = 0;
+    sql << "select count(*) from soci_test where val > 100", into(count);
+    CHECK(count == 0);
+
+    std::vector<int> none(10);
+    sql << "select val from soci_test where val > 100", into(none);
+    CHECK(none.empty());
+}
+
+// Test the cursors mode
+TEST_CASE("PostgreSQL cursors", "[postgresql][cursor]")
+{
+    soci::session sql(backEnd, connectString + " cursors=true");
+
+    table_creator_for_test11 tableCreator(sql);
+
+    for (int i = 0; i != 25; i++)
+    {
+        sql << "insert into soci_test(val) values(:val)", use(i);
+    }
+
+    SECTION("bulk fetch")
+    {
+        std::vector<int> v(10);
+        statement st = (sql.prepare <<
+            "select val from soci_test order by val", into(v));
+
+        std::vector<int> all;
+        st.execute();
+        while (st.fetch())
+        {
+            REQUIRE(v.size() <= 10);
+            all.insert(all.end(), v.begin(), v.end());
+            v.resize(10);
+        }
+
+        REQUIRE(all.size() == 25);
+        for (int i = 0; i != 25; i++)
+        {
+            CHECK(all[i] == i);
+        }
+    }
+
+    SECTION("single into with use elements in a transaction")
+    {
+        transaction tr(sql);
+
+        int val;
+        int const lower = 20;
+        statement st = (sql.prepare <<
+            "select val from soci_test where val >= :lower order by val",
+            into(val), use(lower));
+
+        // check that the statement can be re-executed while the cursor is
+        // still open
+        st.execute(true);
+        CHECK(val == 20);
+
+        st.execute(true);
+        int expected = 20;
+        do
+        {
+            CHECK(val == expected++);
+        }
+        while (st.fetch());
+
+        CHECK(expected == 25);
+
+        tr.commit();
+    }
+
+    SECTION("re-execution in another transaction")
+    {
+        int val;
+        statement st = (sql.prepare <<
+            "select val from soci_test order by val", into(val));
+
+        {
+            transaction tr(sql);
+            st.execute(true);
+            CHECK(val == 0);
+            tr.commit();
+        }
+
+        // the cursor was destroyed by the commit and must not be closed in
+        // the new transaction, as this would abort it
+        transaction tr(sql);
+        st.execute(true);
+        CHECK(val == 0);
+
+        int count = 0;
+        sql << "select count(*) from soci_test", into(count);
+        CHECK(count == 25);
+
+        tr.commit();
+    }
+
+    SECTION("dynamic row")
+    {
+        rowset<row> rs = (sql.prepare << "select val from soci_test order by val");
+
+        int expected = 0;
+        for (rowset<row>::const_iterator it = rs.begin(); it != rs.end(); ++it)
+        {
+            CHECK(it->get<int>(0) == expected++);
+        }
+
+        CHECK(expected == 25);
+    }
+
+    SECTION("no into elements")
+    {
+        // without into elements the query must be executed directly, as
+        // declaring a cursor for it would not run it at all
+        CHECK_THROWS_AS((sql << "select 1/0 from soci_test"), soci_error&);
+    }
+}
+
+// Test the deferred deallocation of the prepared statements
+TEST_CASE("PostgreSQL deferred deallocate", "[postgresql][deallocate]")
+{
+    soci::session sql(backEnd, connectString + " deallocate_batch=3");
+
+    int count = 0;
+    std::string const countQuery =
+        "select count(*) from pg_prepared_statements";
+
+    for (int i = 0; i != 2; i++)
+    {
+        int val = 0;
+        statement st = (sql.prepare << "select :i", use(i), into(val));
+        st.execute(true);
+        CHECK(val == i);
+    }
+
+    // the statements are not deallocated as long as there are less than 3
+    sql << countQuery, into(count);
+    CHECK(count == 2);
+
+    {
+        statement st = (sql.prepare << "select 1");
+        st.execute(true);
+    }
+
+    // now they all should have been deallocated before executing this query
+    sql << countQuery, into(count);
+    CHECK(count == 0);
+
+    // and nothing is deallocated inside a transaction
+    {
+        transaction tr(sql);
+
+        for (int i = 0; i != 4; i++)
+        {
+            statement st = (sql.prepare << "select 1");
+            st.execute(true);
+        }
+
+        sql << countQuery, into(count);
+        CHECK(count == 4);
+
+        tr.commit();
+    }
+
+    // but they are deallocated when it ends, without waiting for the next
+    // query
+    postgresql_session_backend * const backend =
+        static_cast<postgresql_session_backend *>(sql.get_backend());
+    CHECK(backend->pendingDeallocations_.empty());
+
+    sql << countQuery, into(count);
+    CHECK(count == 0);
+
+    {
+        transaction tr(sql);
+
+        for (int i = 0; i != 4; i++)
+        {
+            statement st = (sql.prepare << "select 1");
+            st.execute(true);
+        }
+
+        CHECK_FALSE(backend->pendingDeallocations_.empty());
+        tr.rollback();
+    }
+
+    CHECK(backend->pendingDeallocations_.empty());
+    sql << countQuery, into(count);
+    CHECK(count == 0);
+
+    // immediate deallocation can still be requested
+    soci::session sql2(backEnd, connectString + " deallocate_batch=0");
+    {
+        statement st = (sql2.prepare << "select 1");
+        st.execute(true);
+
+        sql2 << countQuery, into(count);
+        CHECK(count == 1);
+    }
+
+    sql2 << countQuery, into(count);
+    CHECK(count == 0);
+
+    CHECK_THROWS_AS(soci::session(backEnd, connectString + " deallocate_batch=x"),
+        soci_error&);
+}
+
+// Test describing prepared statements without executing them
+TEST_CASE("PostgreSQL describe prepared statement", "[postgresql][row]")
+{
+    soci::session sql(backEnd, connectString);
+
+    table_creator_for_test11 tableCreator(sql);
+
+    for (int i = 1; i != 4; i++)
+    {
+        sql << "insert into soci_test(val) values(:val)", use(i);
+    }
+
+    int v = 1;
+    row r;
+    statement st = (sql.prepare <<
+        "select val, val * 2 as dbl from soci_test where val = :v",
+        use(v), into(r));
+
+    CHECK(st.execute(true));
+    REQUIRE(r.size() == 2);
+    CHECK(r.get_properties(1).get_name() == "dbl");
+    CHECK(r.get_properties(1).get_data_type() == dt_integer);
+    CHECK(r.get<int>(0) == 1);
+    CHECK(r.get<int>(1) == 2);
+
+    // the statement is really executed again with the new parameter value
+    v = 3;
+    CHECK(st.execute(true));
+    CHECK(r.get<int>(0) == 3);
+    CHECK(r.get<int>(1) == 6);
+
+    v = 42;
+    CHECK_FALSE(st.execute(true));
+
+    // describing the statement doesn't execute it, so the side effects only
+    // happen once per execution
+    sql << "create temporary sequence soci_test_seq";
+
+    row seq;
+    statement st2 = (sql.prepare << "select nextval('soci_test_seq') as n",
+        into(seq));
+    CHECK(st2.execute(true));
+    CHECK(seq.get<long long>(0) == 1);
+    CHECK(st2.execute(true));
+    CHECK(seq.get<long long>(0) == 2);
+}
+
+TEST_CASE("PostgreSQL timestamp", "[postgresql][timestamp]")
+{
+    soci::session sql(backEnd, connectString);
+
+    // 2017-04-04 12:34:56.789012
+    timestamp const in(1491309296789012LL);
+
+    timestamp out;
+    sql << "select cast(:t as timestamp)", use(in), into(out);
+    CHECK(out.value == in.value);
+
+    std::vector<timestamp> v(3);
+    sql << "select cast(:t as timestamp) + n * interval '1 second'"
+           " from generate_series(-1, 1) as n", use(in), into(v);
+    REQUIRE(v.size() == 3);
+    CHECK(v[0].value == in.value - 1000000);
+    CHECK(v[2].value == in.value + 1000000);
+}
+
+TEST_CASE("PostgreSQL vector use re-execution", "[postgresql][vector][use]")
+{
+    soci::session sql(backEnd, connectString);
+
+    sql << "create temporary table soci_test(s text)";
+
+    std::vector<std::string> v;
+    v.push_back("first");
+    v.push_back("second");
+
+    statement st = (sql.prepare << "insert into soci_test(s) values(:s)",
+        use(v));
+    st.execute(true);
+
+    // the strings are used without copying them, check that their new
+    // values are used when the statement is executed again
+    v[0] = std::string(100, 'a');
+    v[1] = std::string(100, 'b');
+    st.execute(true);
+
+    std::vector<std::string> all(10);
+    sql << "select s from soci_test order by s", into(all);
+    REQUIRE(all.size() == 4);
+    CHECK(all[0] == v[0]);
+    CHECK(all[1] == v[1]);
+    CHECK(all[2] == "first");
+    CHECK(all[3] == "second");
+}
+
+TEST_CASE("PostgreSQL string_ref", "[postgresql][stringref]")
+{
+    soci::session sql(backEnd, connectString);
+
+    string_ref r;
+    sql << "select 'Hello, world'", into(r);
+    CHECK(r.str() == "Hello, world");
+
+    std::vector<string_ref> v(10);
+    std::vector<indicator> inds(10);
+    sql << "select case when n = 2 then null else repeat('x', n) end"
+           " from generate_series(1, 3) as n order by n", into(v, inds);
+    REQUIRE(v.size() == 3);
+    CHECK(v[0].str() == "x");
+    CHECK(inds[1] == i_null);
+    CHECK(v[2].size == 3);
+}
+
 //
 // Support for soci Common Tests
 //
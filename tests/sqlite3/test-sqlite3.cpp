@@ -12,8 +12,12 @@
 #include <sstream>
 #include <string>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <ctime>
+#if defined(SOCI_HAVE_BOOST) && defined(BOOST_VERSION) && BOOST_VERSION >= 103500
+#include <boost/fusion/include/adapt_struct.hpp>
+#endif
 
 using namespace soci;
 using namespace soci::tests;
@@ -105,6 +109,78 @@ TEST_CASE("SQLite blob", "[sqlite][blob]")
     }
 }
 
+TEST_CASE("SQLite incremental blob", "[sqlite][blob]")
+{
+    soci::session sql(backEnd, connectString);
+
+    blob_table_creator tableCreator(sql);
+
+    sql << "insert into soci_test(id, img) values(7, zeroblob(100))";
+    long long rowid = 0;
+    sql << "select rowid from soci_test where id = 7", into(rowid);
+
+    {
+        blob b(sql);
+        sqlite3_blob_backend *bbe =
+            static_cast<sqlite3_blob_backend *>(b.get_backend());
+
+        bbe->open("soci_test", "img", rowid, true);
+        CHECK(b.get_len() == 100);
+
+        char chunk[10];
+        for (int i = 0; i != 10; ++i)
+        {
+            std::memset(chunk, 'a' + i, sizeof(chunk));
+            b.write_from_start(chunk, sizeof(chunk), i * sizeof(chunk));
+        }
+
+        // the size of an open blob can't change
+        CHECK_THROWS_AS(b.write(95, chunk, sizeof(chunk)), soci_error&);
+        CHECK_THROWS_AS(b.append(chunk, sizeof(chunk)), soci_error&);
+        CHECK_THROWS_AS(b.trim(10), soci_error&);
+
+        bbe->close();
+        CHECK_FALSE(bbe->is_open());
+
+        bbe->open("soci_test", "img", rowid);
+        CHECK(b.read_from_start(chunk, sizeof(chunk), 25) == sizeof(chunk));
+        CHECK(std::strncmp(chunk, "cccccddddd", sizeof(chunk)) == 0);
+        CHECK(b.read(95, chunk, sizeof(chunk)) == 5);
+        CHECK(std::strncmp(chunk, "jjjjj", 5) == 0);
+
+        // blobs opened for reading only can't be written to
+        CHECK_THROWS_AS(b.write(0, chunk, 1), soci_error&);
+
+        CHECK_THROWS_AS(bbe->open("soci_test", "img", rowid + 1), sqlite3_soci_error&);
+        CHECK_FALSE(bbe->is_open());
+    }
+
+    // the data was written to the database
+    blob b(sql);
+    sql << "select img from soci_test where id = 7", into(b);
+    CHECK(b.get_len() == 100);
+    char buf[100];
+    b.read(0, buf, sizeof(buf));
+    CHECK(std::strncmp(buf, "aaaaaaaaaab", 11) == 0);
+}
+
+#if SQLITE_VERSION_NUMBER >= 3007014
+TEST_CASE("SQLite session closed with open blob", "[sqlite][blob]")
+{
+    soci::session* sql = new soci::session(backEnd, connectString);
+    *sql << "create table soci_test(id integer, img blob)";
+    *sql << "insert into soci_test(id, img) values(1, zeroblob(10))";
+
+    blob b(*sql);
+    sqlite3_blob_backend* bbe = static_cast<sqlite3_blob_backend*>(b.get_backend());
+    bbe->open("soci_test", "img", 1);
+    CHECK(b.get_len() == 10);
+
+    // the connection is only really closed when the blob is
+    delete sql;
+}
+#endif
+
 // This test was put in to fix a problem that occurs when there are both
 // into and use elements in the same query and one of them (into) binds
 // to a vector object.
@@ -301,6 +377,601 @@ TEST_CASE("SQLite std::tm bind", "[sqlite][std-tm-bind]")
     CHECK(std::mktime(&result.front()) == std::mktime(&datetime));
 }
 
+TEST_CASE("SQLite timestamp", "[sqlite][timestamp]")
+{
+    soci::session sql(backEnd, connectString);
+    table_creator_for_std_tm_bind tableCreator(sql);
+
+    // 2017-04-04 12:00:00 and 2017-04-05 00:00:00.5
+    timestamp const noon(1491307200000000LL);
+    timestamp const midnight(1491350400500000LL);
+
+    sql << "insert into soci_test(date) values(:dt)", use(midnight);
+
+    timestamp ts;
+    sql << "select date from soci_test where date=:dt", use(noon), into(ts);
+    CHECK(ts.value == noon.value);
+
+    std::string s;
+    sql << "select date from soci_test where date=:dt", use(midnight), into(s);
+    CHECK(s == "2017-04-05 00:00:00.500000");
+
+    std::vector<timestamp> v(10);
+    sql << "select date from soci_test order by date", into(v);
+    REQUIRE(v.size() == 4);
+    CHECK(v[1].value == noon.value);
+    CHECK(v[3].value == midnight.value);
+
+    sql << "delete from soci_test";
+    sql << "insert into soci_test(date) values(:dt)", use(v);
+
+    row r;
+    sql << "select date from soci_test order by date desc", into(r);
+    CHECK(r.get<timestamp>(0).value == 1491350400000000LL);
+}
+
+TEST_CASE("SQLite string_ref", "[sqlite][stringref]")
+{
+    soci::session sql(backEnd, connectString);
+    longlong_table_creator tableCreator(sql);
+
+    sql << "insert into soci_test(val) values(1)";
+    sql << "insert into soci_test(val) values(22)";
+
+    string_ref r;
+    indicator ind;
+    statement st = (sql.prepare <<
+        "select cast(val as text) from soci_test order by val", into(r, ind));
+    st.execute();
+
+    REQUIRE(st.fetch());
+    CHECK(ind == i_ok);
+    CHECK(r.str() == "1");
+
+    REQUIRE(st.fetch());
+    CHECK(r.size == 2);
+    CHECK(std::string(r.data, r.size) == "22");
+
+    CHECK_FALSE(st.fetch());
+
+    sql << "select null", into(r, ind);
+    CHECK(ind == i_null);
+}
+
+#ifdef SOCI_HAVE_BOOST
+TEST_CASE("SQLite bulk boost::tuple", "[sqlite][tuple]")
+{
+    soci::session sql(backEnd, connectString);
+    sql << "create temp table soci_tuple_test(id integer, name text)";
+
+    typedef boost::tuple<int, std::string> row_type;
+
+    std::vector<row_type> in;
+    in.push_back(row_type(1, "one"));
+    in.push_back(row_type(2, "two"));
+    in.push_back(row_type(3, "three"));
+    sql << "insert into soci_tuple_test(id, name) values(:id, :name)", use(in);
+
+    std::vector<row_type> out(10);
+    sql << "select id, name from soci_tuple_test order by id", into(out);
+    REQUIRE(out.size() == 3);
+    CHECK(out[0].get<0>() == 1);
+    CHECK(out[0].get<1>() == "one");
+    CHECK(out[2].get<0>() == 3);
+    CHECK(out[2].get<1>() == "three");
+
+    // rows are fetched in batches of the vector size
+    std::vector<row_type> batch(2);
+    statement st = (sql.prepare <<
+        "select id, name from soci_tuple_test order by id", into(batch));
+    st.execute();
+    REQUIRE(st.fetch());
+    REQUIRE(batch.size() == 2);
+    CHECK(batch[1].get<1>() == "two");
+    REQUIRE(st.fetch());
+    REQUIRE(batch.size() == 1);
+    CHECK(batch[0].get<0>() == 3);
+    CHECK_FALSE(st.fetch());
+
+    sql << "drop table soci_tuple_test";
+}
+
+#if defined(BOOST_VERSION) && BOOST_VERSION >= 103500
+struct fusion_row
+{
+    int id;
+    std::string name;
+};
+
+BOOST_FUSION_ADAPT_STRUCT(fusion_row, (int, id) (std::string, name))
+
+TEST_CASE("SQLite bulk fusion struct", "[sqlite][fusion]")
+{
+    soci::session sql(backEnd, connectString);
+    sql << "create temp table soci_fusion_test(id integer, name text)";
+
+    std::vector<fusion_row> in(3);
+    in[0].id = 1;
+    in[0].name = "one";
+    in[1].id = 2;
+    in[1].name = "two";
+    in[2].id = 3;
+    in[2].name = "three";
+    sql << "insert into soci_fusion_test(id, name) values(:id, :name)", use(in);
+
+    // the columns are copied back into the existing structs after a fetch
+    std::vector<fusion_row> out(10);
+    sql << "select id, name from soci_fusion_test order by id", into(out);
+    REQUIRE(out.size() == 3);
+    CHECK(out[0].id == 1);
+    CHECK(out[0].name == "one");
+    CHECK(out[2].id == 3);
+    CHECK(out[2].name == "three");
+
+    std::vector<fusion_row> batch(2);
+    statement st = (sql.prepare <<
+        "select id, name from soci_fusion_test order by id", into(batch));
+    st.execute();
+    REQUIRE(st.fetch());
+    REQUIRE(batch.size() == 2);
+    CHECK(batch[1].name == "two");
+    REQUIRE(st.fetch());
+    REQUIRE(batch.size() == 1);
+    CHECK(batch[0].id == 3);
+    CHECK_FALSE(st.fetch());
+
+    sql << "drop table soci_fusion_test";
+}
+#endif // BOOST_VERSION
+#endif // SOCI_HAVE_BOOST
+
+TEST_CASE("SQLite bulk fetch of strings", "[sqlite][vector]")
+{
+    soci::session sql(backEnd, connectString);
+    sql << "create temp table soci_bulk_test(id integer, str text)";
+
+    // enough data to need more than one arena block per batch
+    int const rows = 100;
+    for (int i = 0; i != rows; ++i)
+    {
+        std::string const s(200, static_cast<char>('a' + i % 26));
+        indicator ind = i % 10 == 0 ? i_null : i_ok;
+        sql << "insert into soci_bulk_test(id, str) values(:id, :str)",
+            use(i), use(s, ind);
+    }
+
+    std::vector<int> ids(30);
+    std::vector<std::string> strs(30);
+    std::vector<indicator> inds(30);
+    statement st = (sql.prepare <<
+        "select id, str from soci_bulk_test order by id",
+        into(ids), into(strs, inds));
+    st.execute();
+
+    int fetched = 0;
+    while (st.fetch())
+    {
+        for (std::size_t i = 0; i != ids.size(); ++i)
+        {
+            CHECK(ids[i] == fetched);
+            if (fetched % 10 == 0)
+            {
+                CHECK(inds[i] == i_null);
+            }
+            else
+            {
+                CHECK(inds[i] == i_ok);
+                CHECK(strs[i] ==
+                    std::string(200, static_cast<char>('a' + fetched % 26)));
+            }
+
+            ++fetched;
+        }
+    }
+
+    CHECK(fetched == rows);
+
+    sql << "drop table soci_bulk_test";
+}
+
+TEST_CASE("SQLite bulk insert transaction", "[sqlite][vector][transaction]")
+{
+    soci::session sql(backEnd, connectString);
+    sql << "create temp table soci_bulk_test(id integer primary key)";
+
+    std::vector<int> ids;
+    ids.push_back(1);
+    ids.push_back(2);
+    ids.push_back(3);
+
+    // the rows inserted before a failure are kept, as in autocommit mode
+    ids.push_back(2);
+    ids.push_back(4);
+    statement st = (sql.prepare <<
+        "insert into soci_bulk_test(id) values(:id)", use(ids));
+    CHECK_THROWS_AS(st.execute(true), soci_error&);
+    CHECK(st.get_affected_rows() == 3);
+
+    int count = 0;
+    sql << "select count(*) from soci_bulk_test", into(count);
+    CHECK(count == 3);
+
+    // and the user transaction is not affected by the internal one
+    ids.clear();
+    ids.push_back(10);
+    ids.push_back(11);
+    {
+        transaction tr(sql);
+        sql << "insert into soci_bulk_test(id) values(:id)", use(ids);
+        tr.rollback();
+    }
+
+    sql << "select count(*) from soci_bulk_test", into(count);
+    CHECK(count == 3);
+
+    sql << "insert into soci_bulk_test(id) values(:id)", use(ids);
+    sql << "select count(*) from soci_bulk_test", into(count);
+    CHECK(count == 5);
+
+    sql << "drop table soci_bulk_test";
+}
+
+TEST_CASE("SQLite statement cache", "[sqlite][statement-cache]")
+{
+    soci::session sql(backEnd, connectString);
+    sql << "create temp table soci_cache_test(id integer, name text)";
+
+    std::string const query("insert into soci_cache_test(id, name) values(:id, :name)");
+
+    sqlite_api::sqlite3_stmt * first = NULL;
+    {
+        int id = 1;
+        std::string name("one");
+        statement st = (sql.prepare << query, use(id), use(name));
+        st.execute(true);
+        first = static_cast<sqlite3_statement_backend *>(st.get_backend())->stmt_;
+    }
+
+    // the same SQL text reuses the statement prepared above
+    {
+        int id = 2;
+        indicator ind = i_null;
+        std::string name;
+        statement st = (sql.prepare << query, use(id), use(name, ind));
+        CHECK(static_cast<sqlite3_statement_backend *>(st.get_backend())->stmt_ == first);
+        st.execute(true);
+    }
+
+    // the bindings of the previous use were cleared
+    int count = 0;
+    sql << "select count(*) from soci_cache_test where name is null", into(count);
+    CHECK(count == 1);
+
+    // a statement in use is not handed out twice
+    {
+        statement st1 = (sql.prepare << query);
+        statement st2 = (sql.prepare << query);
+        CHECK(static_cast<sqlite3_statement_backend *>(st1.get_backend())->stmt_ !=
+              static_cast<sqlite3_statement_backend *>(st2.get_backend())->stmt_);
+    }
+
+    sql << "drop table soci_cache_test";
+}
+
+TEST_CASE("SQLite row types from affinity", "[sqlite][row]")
+{
+    soci::session sql(backEnd, connectString);
+    sql << "create temp table soci_affinity_test("
+           "a unsigned integer, b floating, c lvarchar, d money, e)";
+    sql << "insert into soci_affinity_test values(1, 2.5, 'three', 4.25, 5)";
+
+    {
+        row r;
+        statement st = (sql.prepare << "select a, b, c, d, e from soci_affinity_test", into(r));
+        st.execute(true);
+
+        CHECK(r.get_properties(0).get_data_type() == dt_integer);
+        CHECK(r.get_properties(1).get_data_type() == dt_double);
+        CHECK(r.get_properties(2).get_data_type() == dt_string);
+        CHECK(r.get_properties(3).get_data_type() == dt_double);
+        CHECK(r.get_properties(4).get_data_type() == dt_string);
+
+        CHECK(r.get<int>(0) == 1);
+        CHECK(r.get<double>(1) == 2.5);
+        CHECK(r.get<std::string>(2) == "three");
+        CHECK(r.get<double>(3) == 4.25);
+        CHECK(r.get<std::string>(4) == "5");
+
+#if SQLITE_VERSION_NUMBER >= 3020000
+        // describing the row didn't execute the statement separately
+        sqlite_api::sqlite3_stmt * const stmt =
+            static_cast<sqlite3_statement_backend *>(st.get_backend())->stmt_;
+        CHECK(sqlite_api::sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_RUN, 0) == 1);
+#endif
+    }
+
+    sql << "drop table soci_affinity_test";
+}
+
+TEST_CASE("SQLite WAL pool", "[sqlite][pool]")
+{
+    char const* const dbname = "soci_wal_test.db";
+
+    {
+        sqlite3_wal_pool pool(dbname, 2, "timeout=5 mmap_size=1048576");
+
+        {
+            session sql(pool.writer());
+            sql << "create table soci_wal_test(id integer)";
+            sql << "insert into soci_wal_test(id) values(1)";
+        }
+
+        std::string const query("select count(*) from soci_wal_test");
+        CHECK(&pool.route(query) == &pool.readers());
+        CHECK(&pool.route(" SELECT 1") == &pool.readers());
+        CHECK(&pool.route("insert into soci_wal_test(id) values(2)") == &pool.writer());
+        CHECK(&pool.route("sel") == &pool.writer());
+
+        // both readers can be used at the same time and see the committed data
+        session reader1(pool.route(query));
+        session reader2(pool.route(query));
+
+        int count = 0;
+        reader1 << query, into(count);
+        CHECK(count == 1);
+
+        std::string mode;
+        reader2 << "pragma journal_mode", into(mode);
+        CHECK(mode == "wal");
+
+        // while a reader is in the middle of a read transaction, the writer
+        // isn't blocked by it and the reader still sees the old snapshot
+        reader2.begin();
+        reader2 << query, into(count);
+        {
+            session sql(pool.writer());
+            sql << "insert into soci_wal_test(id) values(2)";
+        }
+        reader2 << query, into(count);
+        CHECK(count == 1);
+        reader2.commit();
+
+        reader1 << query, into(count);
+        CHECK(count == 2);
+
+        // and the readers can't modify the database
+        CHECK_THROWS_AS(reader1 << "insert into soci_wal_test(id) values(3)",
+                        soci_error&);
+    }
+
+    CHECK_THROWS_AS(sqlite3_wal_pool(dbname, 0), soci_error&);
+
+    // the options are used in the pragmas and so must be valid
+    CHECK_THROWS_AS(sqlite3_wal_pool(dbname, 1, "mmap_size=1;drop"),
+                    soci_error&);
+    CHECK_THROWS_AS(session(backEnd, "dbname=:memory: journal_mode=bogus"),
+                    soci_error&);
+    session sql(backEnd, "dbname=:memory: journal_mode=MEMORY");
+
+    std::remove(dbname);
+}
+
+struct backup_progress : sqlite3_backup_callback
+{
+    backup_progress() : calls_(0), remaining_(-1), abort_(false) {}
+
+    bool on_progress(int remainingPages, int /* totalPages */) SOCI_OVERRIDE
+    {
+        ++calls_;
+        remaining_ = remainingPages;
+        return !abort_;
+    }
+
+    int calls_;
+    int remaining_;
+    bool abort_;
+};
+
+TEST_CASE("SQLite backup", "[sqlite][backup]")
+{
+    char const* const dbname = "soci_backup_test.db";
+    char const* const copyname = "soci_backup_copy.db";
+
+    {
+        session sql(backEnd, dbname);
+        sql << "create table soci_backup_test(id integer, name text)";
+        std::vector<int> ids(1000);
+        std::vector<std::string> names(1000, std::string(100, 'x'));
+        for (int i = 0; i != 1000; ++i)
+            ids[i] = i;
+        sql << "insert into soci_backup_test(id, name) values(:id, :name)",
+            use(ids), use(names);
+    }
+
+    {
+        session mem(backEnd, ":memory:");
+        sqlite3_session_backend* const be =
+            static_cast<sqlite3_session_backend*>(mem.get_backend());
+
+        backup_progress progress;
+        be->load_from(dbname, 10, &progress);
+        CHECK(progress.calls_ > 1);
+        CHECK(progress.remaining_ == 0);
+
+        int count = 0;
+        mem << "select count(*) from soci_backup_test", into(count);
+        CHECK(count == 1000);
+
+        mem << "delete from soci_backup_test where id >= 10";
+        be->save_to(copyname);
+
+        progress.abort_ = true;
+        CHECK_THROWS_AS(be->save_to(dbname, 1, &progress), soci_error&);
+
+        CHECK_THROWS_AS(be->load_from("soci_no_such_file.db"), sqlite3_soci_error&);
+    }
+
+    {
+        session sql(backEnd, copyname);
+        int count = 0;
+        sql << "select count(*) from soci_backup_test", into(count);
+        CHECK(count == 10);
+    }
+
+    {
+        // the aborted backup didn't change the original database
+        session sql(backEnd, dbname);
+        int count = 0;
+        sql << "select count(*) from soci_backup_test", into(count);
+        CHECK(count == 1000);
+    }
+
+    std::remove(dbname);
+    std::remove(copyname);
+}
+
+TEST_CASE("SQLite bulk insert of dates", "[sqlite][vector][std-tm-bind]")
+{
+    soci::session sql(backEnd, connectString);
+    sql << "create temp table soci_dates_test(id integer, d datetime)";
+
+    std::vector<int> ids;
+    std::vector<std::tm> dates;
+    for (int i = 0; i != 3; ++i)
+    {
+        std::tm t = std::tm();
+        t.tm_year = 120;
+        t.tm_mon = 0;
+        t.tm_mday = i + 1;
+        t.tm_hour = i;
+        ids.push_back(i);
+        dates.push_back(t);
+    }
+    sql << "insert into soci_dates_test(id, d) values(:id, :d)", use(ids), use(dates);
+
+    // the single date buffer is reused by each execution
+    int id = 10;
+    std::tm t = dates[0];
+    statement st = (sql.prepare << "insert into soci_dates_test(id, d) values(:id, :d)",
+                    use(id), use(t));
+    st.execute(true);
+    id = 11;
+    t.tm_mday = 28;
+    st.execute(true);
+
+    std::vector<std::string> texts(10);
+    sql << "select d from soci_dates_test order by id", into(texts);
+    REQUIRE(texts.size() == 5);
+    CHECK(texts[0] == "2020-01-01 00:00:00");
+    CHECK(texts[1] == "2020-01-02 01:00:00");
+    CHECK(texts[2] == "2020-01-03 02:00:00");
+    CHECK(texts[3] == "2020-01-01 00:00:00");
+    CHECK(texts[4] == "2020-01-28 00:00:00");
+
+    sql << "drop table soci_dates_test";
+}
+
+struct scale_function
+{
+    explicit scale_function(double factor) : factor_(factor) {}
+
+    void operator()(sqlite3_function_args const& args,
+                    sqlite3_function_result& result) const
+    {
+        if (args.is_null(0))
+            return;
+
+        if (args.get<double>(0) < 0)
+            throw soci_error("negative value");
+
+        result.set(args.get<double>(0) * factor_);
+    }
+
+    double factor_;
+};
+
+struct concat_aggregate
+{
+    void step(sqlite3_function_args const& args)
+    {
+        if (!value_.empty())
+            value_ += args.get<std::string>(1);
+        value_ += args.get<std::string>(0);
+    }
+
+    void inverse(sqlite3_function_args const& args)
+    {
+        std::string::size_type const len =
+            args.get<std::string>(0).size() + args.get<std::string>(1).size();
+        value_.erase(0, (std::min)(len, value_.size()));
+    }
+
+    void value(sqlite3_function_result& result) const
+    {
+        result.set(value_);
+    }
+
+    void final(sqlite3_function_result& result) const
+    {
+        if (value_.empty())
+            result.set_null();
+        else
+            result.set(value_);
+    }
+
+    std::string value_;
+};
+
+TEST_CASE("SQLite user-defined functions", "[sqlite][function]")
+{
+    soci::session sql(backEnd, connectString);
+    sqlite3_session_backend* const be =
+        static_cast<sqlite3_session_backend*>(sql.get_backend());
+
+    be->create_function("soci_scale", 1, scale_function(2.5));
+    be->create_aggregate<concat_aggregate>("soci_concat", 2);
+
+    sql << "create temp table soci_function_test(id integer, name text, x real)";
+    sql << "insert into soci_function_test values(1, 'a', 1.0)";
+    sql << "insert into soci_function_test values(2, 'b', 2.0)";
+    sql << "insert into soci_function_test values(3, 'c', null)";
+
+    double sum = 0;
+    sql << "select sum(soci_scale(x)) from soci_function_test", into(sum);
+    CHECK(sum == 7.5);
+
+    std::string names;
+    sql << "select soci_concat(name, ',') from soci_function_test", into(names);
+    CHECK(names == "a,b,c");
+
+    // the aggregate of no rows
+    indicator ind = i_ok;
+    sql << "select soci_concat(name, ',') from soci_function_test where id > 3",
+        into(names, ind);
+    CHECK(ind == i_null);
+
+    // errors are reported as SQL errors
+    CHECK_THROWS_AS((sql << "select soci_scale(-1)", into(sum)), soci_error&);
+
+    // and the argument count is checked by SQLite
+    CHECK_THROWS_AS((sql << "select soci_scale(1, 2)", into(sum)), soci_error&);
+
+#if SQLITE_VERSION_NUMBER >= 3025000
+    be->create_window_function<concat_aggregate>("soci_concat_window", 2);
+
+    std::vector<std::string> windows(3);
+    sql << "select soci_concat_window(name, '') over"
+           " (order by id rows between 1 preceding and current row)"
+           " from soci_function_test order by id", into(windows);
+    REQUIRE(windows.size() == 3);
+    CHECK(windows[0] == "a");
+    CHECK(windows[1] == "ab");
+    CHECK(windows[2] == "bc");
+#endif
+
+    sql << "drop table soci_function_test";
+}
+
 // DDL Creation objects for common tests
 struct table_creator_one : public table_creator_base
 {